@@ -3,7 +3,15 @@
 #include <array>
 #include <numeric>
 #include <list>
+#include <tuple>
+#include <unordered_map>
 #include "zippp/zip.h"
+#include "zippp/transform.h"
+#include "zippp/columns.h"
+#include "zippp/simd.h"
+#include "zippp/pipeline.h"
+#include "zippp/bits.h"
+#include "zippp/hash.h"
 
 
 constexpr int num_items = 1000;
@@ -77,9 +85,162 @@ static void BM_indexiter(benchmark::State& state) {
         benchmark::DoNotOptimize(v+=value);
     }
 }
+template<zippp::store_policy Store>
+static void BM_transforminto(benchmark::State& state) {
+    const std::size_t rows = static_cast<std::size_t>(state.range(0));
+    std::vector<double> in1(rows, 1.5);
+    std::vector<long long> in2(rows, 3);
+    std::vector<double> out(rows);
+    for (auto _ : state) {
+        zippp::transform_into<Store>(zippp::zip(in1, in2), zippp::zip(out),
+            [](double a, long long b) { return a * b; });
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * rows * (sizeof(double) * 2 + sizeof(long long)));
+}
+
+static void BM_bitpackediter(benchmark::State& state) {
+    std::vector<unsigned> values(num_items * 64);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<unsigned>(i % 4096);
+    }
+    zippp::bitpacked_column<12, unsigned> packed(values.begin(), values.end());
+    zippp::delta_column<unsigned> delta(values.begin(), values.end());
+    long long v = 0;
+    for (auto _ : state) {
+        long long value = 0;
+        for(const auto& [val1, val2] : zippp::zip(packed, delta)){
+            value += val1 + val2;
+        }
+        benchmark::DoNotOptimize(v+=value);
+    }
+}
+
+static void BM_zipppaxpy(benchmark::State& state) {
+    bench_cols<std::vector<float>, std::vector<float>, std::vector<float>> cols;
+    for (auto _ : state) {
+        for(auto&& [x, y, out] : zippp::zip(cols.col1, cols.col2, cols.col3)){
+            out = 2.0f * x + y;
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+static void BM_simdaxpy(benchmark::State& state) {
+    bench_cols<std::vector<float>, std::vector<float>, std::vector<float>> cols;
+    for (auto _ : state) {
+        zippp::simd_for_each(zippp::zip(std::as_const(cols.col1), std::as_const(cols.col2), cols.col3),
+            [](const auto& x, const auto& y, auto& out){ out = 2.0f * x + y; });
+        benchmark::ClobberMemory();
+    }
+}
+
+static void BM_multipass(benchmark::State& state) {
+    const std::size_t rows = static_cast<std::size_t>(state.range(0));
+    std::vector<double> values(rows, 3.0);
+    std::vector<double> weights(rows, 0.5);
+    std::vector<double> scores(rows);
+    for (auto _ : state) {
+        for(auto&& [v, w, s] : zippp::zip(values, weights, scores)){
+            v = v * 0.5 + 1.0;
+        }
+        for(auto&& [v, w, s] : zippp::zip(values, weights, scores)){
+            s = v * w;
+        }
+        for(auto&& [v, w, s] : zippp::zip(values, weights, scores)){
+            s = s > 1.0 ? s : 0.0;
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+static void BM_pipeline(benchmark::State& state) {
+    const std::size_t rows = static_cast<std::size_t>(state.range(0));
+    std::vector<double> values(rows, 3.0);
+    std::vector<double> weights(rows, 0.5);
+    std::vector<double> scores(rows);
+    auto pipe = zippp::pipeline(zippp::zip(values, weights, scores))
+        .then([](double& v, double, double&) { v = v * 0.5 + 1.0; })
+        .then([](double v, double w, double& s) { s = v * w; })
+        .then([](double, double, double& s) { s = s > 1.0 ? s : 0.0; });
+    for (auto _ : state) {
+        pipe.run();
+        benchmark::ClobberMemory();
+    }
+}
+
+static void BM_boolzip(benchmark::State& state) {
+    std::vector<bool> a(num_items * 64), b(num_items * 64), out(num_items * 64);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = i % 3 == 0;
+        b[i] = i % 5 == 0;
+    }
+    for (auto _ : state) {
+        for(auto&& [x, y, o] : zippp::zip(a, b, out)){
+            o = x && !y;
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+static void BM_wordzip(benchmark::State& state) {
+    std::vector<bool> a(num_items * 64), b(num_items * 64), out(num_items * 64);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = i % 3 == 0;
+        b[i] = i % 5 == 0;
+    }
+    for (auto _ : state) {
+        for(auto&& [x, y, o] : zippp::zip_words(a, b, out)){
+            o = x & ~y;
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+struct tuple_hash {
+    std::size_t operator()(const std::tuple<int, long long>& key) const {
+        return std::hash<int>{}(std::get<0>(key)) * 31 + std::hash<long long>{}(std::get<1>(key));
+    }
+};
+
+static void BM_unorderedmapagg(benchmark::State& state) {
+    const bench_t cols;
+    for (auto _ : state) {
+        std::unordered_map<std::tuple<int, long long>, double, tuple_hash> groups;
+        for(const auto& [key1, value, key2] : zippp::zip(cols.col1, cols.col2, cols.col3)){
+            groups[{key1 % 10, key2 % 7}] += value;
+        }
+        benchmark::DoNotOptimize(groups);
+    }
+}
+
+static void BM_hashaggregate(benchmark::State& state) {
+    bench_t cols;
+    for(std::size_t i = 0; i < num_items; ++i) {
+        cols.col1[i] %= 10;
+        cols.col3[i] %= 7;
+    }
+    for (auto _ : state) {
+        auto groups = zippp::hash_aggregate(zippp::zip(cols.col1, cols.col3), zippp::zip(cols.col2),
+            [](double& acc, double value) { acc += value; }, 0.0);
+        benchmark::DoNotOptimize(groups);
+    }
+}
+
 // Register the function as a benchmark
 BENCHMARK(BM_normaliter);
 BENCHMARK(BM_indexiter);
 BENCHMARK(BM_zipppiter);
+BENCHMARK(BM_zipppaxpy);
+BENCHMARK(BM_simdaxpy);
+BENCHMARK(BM_bitpackediter);
+BENCHMARK(BM_boolzip);
+BENCHMARK(BM_wordzip);
+BENCHMARK(BM_unorderedmapagg);
+BENCHMARK(BM_hashaggregate);
+BENCHMARK_TEMPLATE(BM_transforminto, zippp::store_policy::normal)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_transforminto, zippp::store_policy::streaming)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK(BM_multipass)->Arg(1 << 22);
+BENCHMARK(BM_pipeline)->Arg(1 << 22);
 
-BENCHMARK_MAIN();
\ No newline at end of file
+BENCHMARK_MAIN();
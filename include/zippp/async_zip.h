@@ -0,0 +1,584 @@
+#ifndef ZIPPP_ASYNC_ZIP
+#define ZIPPP_ASYNC_ZIP
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "zippp/async_zip.h requires C++20 coroutines"
+#endif
+
+#include "zippp/zip.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace zippp
+{
+namespace detail
+{
+/// Suspends the current coroutine and transfers control to the one waiting on it
+struct resume_consumer
+{
+    std::coroutine_handle<> consumer;
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<>) const noexcept { return consumer; }
+    void await_resume() const noexcept {}
+};
+} // namespace detail
+
+/**
+ * @brief Lazily evaluated coroutine producing a sequence of values that may be awaited
+ *
+ * Each `co_await gen.next()` resumes the coroutine until it yields its next value, which is returned as an
+ * std::optional. An empty optional means the coroutine has finished. Exceptions thrown by the coroutine are rethrown
+ * from the next call to next(). Only one consumer may await the generator at a time.
+ */
+template<typename T>
+class async_generator
+{
+public:
+    struct promise_type
+    {
+        std::optional<T> value;
+        std::exception_ptr error;
+        std::coroutine_handle<> consumer = std::noop_coroutine();
+
+        async_generator get_return_object()
+        {
+            return async_generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        detail::resume_consumer final_suspend() const noexcept { return {consumer}; }
+
+        template<typename U>
+        detail::resume_consumer yield_value(U&& val)
+        {
+            value.emplace(std::forward<U>(val));
+            return {consumer};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    async_generator(async_generator&& in) noexcept : coro(std::exchange(in.coro, nullptr)) {}
+    async_generator& operator=(async_generator&& in) noexcept
+    {
+        std::swap(coro, in.coro);
+        return *this;
+    }
+    async_generator(const async_generator&) = delete;
+    async_generator& operator=(const async_generator&) = delete;
+    ~async_generator()
+    {
+        if(coro)
+        {
+            coro.destroy();
+        }
+    }
+
+    /// Awaitable resuming the generator until it produces its next value
+    auto next()
+    {
+        struct awaiter
+        {
+            handle_type coro;
+
+            bool await_ready() const noexcept
+            {
+                return !coro || coro.done();
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept
+            {
+                coro.promise().consumer = consumer;
+                return coro;
+            }
+            std::optional<T> await_resume()
+            {
+                if(!coro)
+                {
+                    return std::nullopt;
+                }
+                auto& promise = coro.promise();
+                if(promise.error)
+                {
+                    std::rethrow_exception(std::exchange(promise.error, nullptr));
+                }
+                return std::exchange(promise.value, std::nullopt);
+            }
+        };
+        return awaiter{coro};
+    }
+
+private:
+    explicit async_generator(handle_type coro_) : coro(coro_) {}
+
+    handle_type coro;
+};
+
+/**
+ * @brief Thread safe queue that producers push into and a single coroutine awaits
+ *
+ * A consumer waiting on the channel is resumed on the thread that pushes the value it was waiting for.
+ */
+template<typename T>
+class async_channel
+{
+public:
+    /// Add a value, resuming the consumer if it is waiting for it
+    void push(T value)
+    {
+        std::coroutine_handle<> waiting;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(value));
+            waiting = take_waiter();
+        }
+        if(waiting)
+        {
+            waiting.resume();
+        }
+    }
+
+    /// Mark the end of the values. The consumer receives the remaining values and is then told the channel is empty
+    void close()
+    {
+        std::coroutine_handle<> waiting;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            waiting = take_waiter();
+        }
+        if(waiting)
+        {
+            waiting.resume();
+        }
+    }
+
+    /// Awaitable for the next value, or an empty optional once the channel is closed and drained
+    auto next()
+    {
+        struct awaiter
+        {
+            async_channel& channel;
+
+            bool await_ready() { return channel.ready(1); }
+            bool await_suspend(std::coroutine_handle<> consumer) { return channel.wait(consumer, 1); }
+            std::optional<T> await_resume()
+            {
+                std::lock_guard<std::mutex> lock(channel.mutex);
+                if(channel.queue.empty())
+                {
+                    return std::nullopt;
+                }
+                std::optional<T> value(std::move(channel.queue.front()));
+                channel.queue.pop_front();
+                return value;
+            }
+        };
+        return awaiter{*this};
+    }
+
+    /// Awaitable for the next max_count values. Returns fewer only once the channel is closed
+    auto next_batch(std::size_t max_count)
+    {
+        struct awaiter
+        {
+            async_channel& channel;
+            std::size_t max_count;
+
+            bool await_ready() { return channel.ready(max_count); }
+            bool await_suspend(std::coroutine_handle<> consumer) { return channel.wait(consumer, max_count); }
+            std::vector<T> await_resume()
+            {
+                std::lock_guard<std::mutex> lock(channel.mutex);
+                const auto count = std::min(max_count, channel.queue.size());
+                std::vector<T> values(std::make_move_iterator(channel.queue.begin()),
+                                      std::make_move_iterator(channel.queue.begin() + count));
+                channel.queue.erase(channel.queue.begin(), channel.queue.begin() + count);
+                return values;
+            }
+        };
+        return awaiter{*this, max_count};
+    }
+
+private:
+    bool ready(std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return closed || queue.size() >= count;
+    }
+
+    /// Register the consumer unless the values arrived in the meantime. Returns whether the consumer suspended
+    bool wait(std::coroutine_handle<> consumer, std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(closed || queue.size() >= count)
+        {
+            return false;
+        }
+        waiter = consumer;
+        wanted = count;
+        return true;
+    }
+
+    std::coroutine_handle<> take_waiter()
+    {
+        if(waiter && (closed || queue.size() >= wanted))
+        {
+            return std::exchange(waiter, nullptr);
+        }
+        return nullptr;
+    }
+
+    std::mutex mutex;
+    std::deque<T> queue;
+    bool closed = false;
+    std::coroutine_handle<> waiter;
+    std::size_t wanted = 1;
+};
+
+namespace detail
+{
+template<typename Awaiter>
+using await_result_t = decltype(std::declval<Awaiter&>().await_resume());
+
+/// Type of the values produced by a source, ie an object whose next() is awaitable and returns an std::optional
+template<typename Source>
+using source_value_t = typename await_result_t<decltype(std::declval<Source&>().next())>::value_type;
+
+template<typename Source, typename = void>
+struct has_next_batch : std::false_type {};
+
+template<typename Source>
+struct has_next_batch<Source, std::void_t<decltype(std::declval<Source&>().next_batch(std::size_t{}))>>
+    : std::true_type {};
+
+/// Count of unfinished when_all tasks, plus one held by the awaiting coroutine until all tasks are started
+struct when_all_counter
+{
+    std::atomic<std::size_t> count;
+    std::coroutine_handle<> parent;
+
+    /// Returns true for the last arrival
+    bool arrive() noexcept
+    {
+        return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+};
+
+/**
+ * @brief Lazily started coroutine whose completion is reported to a when_all_counter
+ */
+template<typename R>
+class when_all_task
+{
+public:
+    struct promise_type
+    {
+        when_all_counter* counter = nullptr;
+        std::optional<R> result;
+        std::exception_ptr error;
+
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> coro) const noexcept
+            {
+                auto& counter = *coro.promise().counter;
+                if(counter.arrive())
+                {
+                    return counter.parent;
+                }
+                return std::noop_coroutine();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        when_all_task get_return_object()
+        {
+            return when_all_task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        final_awaiter final_suspend() const noexcept { return {}; }
+
+        template<typename U>
+        void return_value(U&& value)
+        {
+            result.emplace(std::forward<U>(value));
+        }
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    when_all_task(when_all_task&& in) noexcept : coro(std::exchange(in.coro, nullptr)) {}
+    when_all_task(const when_all_task&) = delete;
+    ~when_all_task()
+    {
+        if(coro)
+        {
+            coro.destroy();
+        }
+    }
+
+    void start(when_all_counter& counter)
+    {
+        coro.promise().counter = &counter;
+        coro.resume();
+    }
+
+    R take()
+    {
+        auto& promise = coro.promise();
+        if(promise.error)
+        {
+            std::rethrow_exception(promise.error);
+        }
+        return std::move(*promise.result);
+    }
+
+private:
+    explicit when_all_task(std::coroutine_handle<promise_type> coro_) : coro(coro_) {}
+
+    std::coroutine_handle<promise_type> coro;
+};
+
+/// Starts every task and resumes the awaiting coroutine once all of them have finished
+template<typename ... Tasks>
+struct when_all_awaiter
+{
+    std::tuple<Tasks...>& tasks;
+    when_all_counter counter{sizeof...(Tasks) + 1, nullptr};
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> parent)
+    {
+        counter.parent = parent;
+        std::apply([this](auto&... task) { (task.start(counter), ...); }, tasks);
+        return !counter.arrive();
+    }
+    void await_resume() const noexcept {}
+};
+
+template<typename Source>
+when_all_task<std::optional<source_value_t<Source>>> fetch_next(Source& source)
+{
+    co_return co_await source.next();
+}
+
+template<typename Source>
+when_all_task<std::vector<source_value_t<Source>>> fetch_batch(Source& source, std::size_t max_count)
+{
+    if constexpr (has_next_batch<Source>::value)
+    {
+        co_return co_await source.next_batch(max_count);
+    }
+    else
+    {
+        std::vector<source_value_t<Source>> values;
+        values.reserve(max_count);
+        while(values.size() < max_count)
+        {
+            auto value = co_await source.next();
+            if(!value)
+            {
+                break;
+            }
+            values.push_back(std::move(*value));
+        }
+        co_return values;
+    }
+}
+
+/// Sources passed as lvalues are referenced, temporaries are moved into the coroutine
+template<typename Source>
+using stored_source_t = std::conditional_t<std::is_lvalue_reference_v<Source>, Source, std::decay_t<Source>>;
+
+template<typename ... Sources>
+async_generator<std::tuple<source_value_t<std::decay_t<Sources>>...>>
+async_zip_impl(stored_source_t<Sources> ... sources)
+{
+    while(true)
+    {
+        auto tasks = std::make_tuple(fetch_next(sources)...);
+        co_await when_all_awaiter<decltype(fetch_next(sources))...>{tasks};
+        auto values = std::apply([](auto&... task) { return std::make_tuple(task.take()...); }, tasks);
+        if(!std::apply([](auto&... value) { return (value.has_value() && ...); }, values))
+        {
+            co_return;
+        }
+        co_yield std::apply([](auto&... value) {
+            return std::tuple<source_value_t<std::decay_t<Sources>>...>(std::move(*value)...);
+        }, values);
+    }
+}
+
+template<typename ... Sources>
+async_generator<std::tuple<source_value_t<std::decay_t<Sources>>...>>
+async_zip_batched_impl(std::size_t batch_size, stored_source_t<Sources> ... sources)
+{
+    using row_type = std::tuple<source_value_t<std::decay_t<Sources>>...>;
+    batch_size = std::max<std::size_t>(batch_size, 1);
+    while(true)
+    {
+        auto tasks = std::make_tuple(fetch_batch(sources, batch_size)...);
+        co_await when_all_awaiter<decltype(fetch_batch(sources, batch_size))...>{tasks};
+        auto batches = std::apply([](auto&... task) { return std::make_tuple(task.take()...); }, tasks);
+
+        // Stop at the end of the shortest source, like zip over collections of unequal length would
+        const std::size_t rows = std::apply([](auto&... batch) { return std::min({batch.size()...}); }, batches);
+        std::apply([rows](auto&... batch) { (batch.erase(batch.begin() + rows, batch.end()), ...); }, batches);
+
+        auto zipped = std::apply([](auto&... batch) { return zippp::zip(batch...); }, batches);
+        for(auto it = zipped.begin(); it != zipped.end(); ++it)
+        {
+            co_yield apply_value([](auto&&... value) { return row_type(std::move(value)...); }, *it);
+        }
+        if(rows < batch_size)
+        {
+            co_return;
+        }
+    }
+}
+
+template<typename R>
+struct sync_wait_state
+{
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::optional<R> result;
+    std::exception_ptr error;
+};
+
+template<>
+struct sync_wait_state<void>
+{
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::exception_ptr error;
+};
+
+/// Coroutine that signals the thread blocked in sync_wait only once it has fully suspended
+struct sync_wait_task
+{
+    struct promise_type
+    {
+        std::mutex* mutex = nullptr;
+        std::condition_variable* finished = nullptr;
+        bool* done = nullptr;
+
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> coro) const noexcept
+            {
+                auto& promise = coro.promise();
+                std::lock_guard<std::mutex> lock(*promise.mutex);
+                *promise.done = true;
+                promise.finished->notify_all();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        sync_wait_task get_return_object()
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        final_awaiter final_suspend() const noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> coro;
+};
+
+template<typename R, typename Awaitable>
+sync_wait_task run_sync_wait(Awaitable& awaitable, sync_wait_state<R>& state)
+{
+    try
+    {
+        if constexpr (std::is_void_v<R>)
+        {
+            co_await awaitable;
+        }
+        else
+        {
+            state.result.emplace(co_await awaitable);
+        }
+    }
+    catch(...)
+    {
+        state.error = std::current_exception();
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Zip several asynchronous sources into a generator of rows
+ *
+ * A source is any object with a next() member returning an awaitable std::optional, such as async_channel and
+ * async_generator. For every row the next value of all sources is requested at once, so a slow source does not delay
+ * fetching from the others. The generator finishes when any source runs out.
+ *
+ * Sources passed as lvalues must outlive the generator, temporaries are moved into it.
+ */
+template<typename ... Sources>
+auto async_zip(Sources&& ... sources)
+{
+    return detail::async_zip_impl<Sources...>(std::forward<Sources>(sources)...);
+}
+
+/**
+ * @brief Like async_zip, but requests up to batch_size values from every source at once
+ *
+ * Sources with a next_batch(std::size_t) member (such as async_channel) fetch a whole batch in one operation. This
+ * cuts the synchronization per row when the sources are fed by other threads.
+ */
+template<typename ... Sources>
+auto async_zip_batched(std::size_t batch_size, Sources&& ... sources)
+{
+    return detail::async_zip_batched_impl<Sources...>(batch_size, std::forward<Sources>(sources)...);
+}
+
+/**
+ * @brief Block the calling thread until the awaitable completes and return its result
+ *
+ * Allows synchronous code to drive coroutines, eg `while(auto row = zippp::sync_wait(gen.next()))`.
+ */
+template<typename Awaitable>
+auto sync_wait(Awaitable&& awaitable)
+{
+    using result_type = detail::await_result_t<std::remove_reference_t<Awaitable>>;
+    detail::sync_wait_state<result_type> state;
+    auto task = detail::run_sync_wait(awaitable, state);
+    task.coro.promise().mutex = &state.mutex;
+    task.coro.promise().finished = &state.finished;
+    task.coro.promise().done = &state.done;
+    task.coro.resume();
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.finished.wait(lock, [&state] { return state.done; });
+    }
+    task.coro.destroy();
+    if(state.error)
+    {
+        std::rethrow_exception(state.error);
+    }
+    if constexpr (!std::is_void_v<result_type>)
+    {
+        return std::move(*state.result);
+    }
+}
+} // namespace zippp
+#endif
@@ -0,0 +1,325 @@
+#ifndef ZIPPP_BITS
+#define ZIPPP_BITS
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace zippp
+{
+namespace detail
+{
+/// Rows per word of a bit column
+constexpr std::size_t word_bits = 64;
+
+template<typename T>
+struct is_bit_column : std::false_type {};
+
+template<typename Alloc>
+struct is_bit_column<std::vector<bool, Alloc>> : std::true_type {};
+
+template<std::size_t N>
+struct is_bit_column<std::bitset<N>> : std::true_type {};
+
+template<typename T>
+struct is_bitset : std::false_type {};
+
+template<std::size_t N>
+struct is_bitset<std::bitset<N>> : std::true_type {};
+
+/**
+ * @brief The words backing a std::vector<bool> or std::bitset, or nullptr if they cannot be reached
+ *
+ * This is the only code in zippp that depends on standard library internals. libstdc++ stores both containers as
+ * arrays of unsigned long, with row i in bit i % 64 of word i / 64, which on LP64 targets are exactly the words
+ * zip_words works with. The internals are only used for the exact libstdc++ types: std::vector<bool> must iterate with
+ * std::_Bit_iterator or std::_Bit_const_iterator, and std::bitset must be nothing but its array of words. The checked
+ * containers of _GLIBCXX_DEBUG and every other standard library get nullptr.
+ */
+template<typename C>
+auto library_words(C& col)
+{
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)
+    using word_type = std::conditional_t<std::is_const_v<C>, const std::uint64_t, std::uint64_t>;
+    using col_type = std::remove_const_t<C>;
+    if constexpr (!std::is_same_v<unsigned long, std::uint64_t>)
+    {
+        return nullptr;
+    }
+    else if constexpr (is_bitset<col_type>::value)
+    {
+        if constexpr (sizeof(col_type) == (col_type().size() + word_bits - 1) / word_bits * sizeof(std::uint64_t))
+        {
+            return reinterpret_cast<word_type*>(&col);
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+    else if constexpr (std::is_same_v<decltype(col.begin()), std::_Bit_iterator> ||
+                       std::is_same_v<decltype(col.begin()), std::_Bit_const_iterator>)
+    {
+        return static_cast<word_type*>(col.begin()._M_p);
+    }
+    else
+    {
+        return nullptr;
+    }
+#else
+    (void)col;
+    return nullptr;
+#endif
+}
+
+/**
+ * @brief Word level access to the bits of a std::vector<bool> or std::bitset
+ *
+ * The words are read and written directly where library_words() can reach them. Otherwise the bits are gathered and
+ * scattered one at a time.
+ */
+template<typename Col>
+struct bit_access
+{
+    static std::size_t size(const Col& col)
+    {
+        return col.size();
+    }
+
+    template<typename C>
+    static auto words(C& col)
+    {
+        return library_words(col);
+    }
+
+    template<typename C>
+    static std::uint64_t load(C& col, std::size_t word)
+    {
+        auto data = words(col);
+        if constexpr (!std::is_same_v<decltype(data), std::nullptr_t>)
+        {
+            return data[word];
+        }
+        else
+        {
+            const std::size_t first = word * word_bits;
+            const std::size_t last = std::min(size(col), first + word_bits);
+            std::uint64_t bits = 0;
+            for(std::size_t i = first; i < last; ++i)
+            {
+                bits |= static_cast<std::uint64_t>(static_cast<bool>(col[i])) << (i - first);
+            }
+            return bits;
+        }
+    }
+
+    /// Overwrite the bits of the word set in mask with those of value
+    static void store(Col& col, std::size_t word, std::uint64_t value, std::uint64_t mask)
+    {
+        auto data = words(col);
+        if constexpr (!std::is_same_v<decltype(data), std::nullptr_t>)
+        {
+            data[word] = (data[word] & ~mask) | (value & mask);
+        }
+        else
+        {
+            const std::size_t first = word * word_bits;
+            for(std::size_t i = 0; i < word_bits && mask >> i; ++i)
+            {
+                if(mask >> i & 1)
+                {
+                    col[first + i] = static_cast<bool>(value >> i & 1);
+                }
+            }
+        }
+    }
+};
+} // namespace detail
+
+/**
+ * @brief Proxy for 64 consecutive rows of one bit column, bound by zippp::zip_words
+ *
+ * Converts to a std::uint64_t with row first_row() + i in bit i. Rows past the end of the zip read as 0, and are left
+ * untouched when the word is assigned. Assigning needs a non-const column.
+ */
+template<typename Col>
+class bit_word
+{
+public:
+    bit_word(Col& col_, std::size_t word_, std::uint64_t valid_) : col(&col_), word(word_), valid(valid_) {}
+    bit_word(const bit_word&) = default;
+
+    std::uint64_t value() const
+    {
+        return detail::bit_access<std::remove_const_t<Col>>::load(*col, word) & valid;
+    }
+
+    operator std::uint64_t() const
+    {
+        return value();
+    }
+
+    /// Bits of the rows that are part of the zip
+    std::uint64_t mask() const
+    {
+        return valid;
+    }
+
+    /// Row of bit 0
+    std::size_t first_row() const
+    {
+        return word * detail::word_bits;
+    }
+
+    /// Row first_row() + bit
+    bool operator[](std::size_t bit) const
+    {
+        return value() >> bit & 1;
+    }
+
+    const bit_word& operator=(std::uint64_t bits) const
+    {
+        static_assert(!std::is_const_v<Col>, "Cannot assign to a word of a const bit column");
+        detail::bit_access<Col>::store(*col, word, bits, valid);
+        return *this;
+    }
+
+    /// Assigns the bits, not the proxy
+    const bit_word& operator=(const bit_word& in) const
+    {
+        return *this = in.value();
+    }
+
+    const bit_word& operator&=(std::uint64_t bits) const
+    {
+        return *this = value() & bits;
+    }
+    const bit_word& operator|=(std::uint64_t bits) const
+    {
+        return *this = value() | bits;
+    }
+    const bit_word& operator^=(std::uint64_t bits) const
+    {
+        return *this = value() ^ bits;
+    }
+
+private:
+    Col* col;
+    std::size_t word;
+    std::uint64_t valid;
+};
+
+namespace detail
+{
+/// Forward iterator over the words of zipped bit columns. Dereferencing returns a tuple of bit_word proxies
+template<typename ... Cols>
+class word_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::tuple<bit_word<Cols>...>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    word_iterator(const std::tuple<Cols*...>& cols_, std::size_t word_, std::size_t rows_)
+        : cols(cols_), word(word_), rows(rows_) {}
+
+    reference operator*() const
+    {
+        const std::size_t left = rows - word * word_bits;
+        const std::uint64_t valid = left >= word_bits ? ~std::uint64_t(0) : (std::uint64_t(1) << left) - 1;
+        return std::apply([&](auto* ... col) { return value_type(bit_word<Cols>(*col, word, valid)...); }, cols);
+    }
+
+    word_iterator& operator++()
+    {
+        ++word;
+        return *this;
+    }
+    word_iterator operator++(int)
+    {
+        auto temp = *this;
+        ++word;
+        return temp;
+    }
+
+    bool operator==(const word_iterator& in) const
+    {
+        return word == in.word;
+    }
+    bool operator!=(const word_iterator& in) const
+    {
+        return !(*this == in);
+    }
+
+private:
+    std::tuple<Cols*...> cols;
+    std::size_t word;
+    std::size_t rows;
+};
+
+/// Range returned by zippp::zip_words
+template<typename ... Cols>
+class word_zip
+{
+public:
+    using iterator = word_iterator<Cols...>;
+
+    explicit word_zip(Cols& ... cols_)
+        : cols(&cols_...), num_rows(std::min({bit_access<std::remove_const_t<Cols>>::size(cols_)...})) {}
+
+    iterator begin() const
+    {
+        return iterator(cols, 0, num_rows);
+    }
+
+    iterator end() const
+    {
+        return iterator(cols, size(), num_rows);
+    }
+
+    /// Number of words, the last of which may be partial
+    std::size_t size() const
+    {
+        return (num_rows + word_bits - 1) / word_bits;
+    }
+
+    /// Number of rows, the length of the shortest column
+    std::size_t rows() const
+    {
+        return num_rows;
+    }
+
+private:
+    std::tuple<Cols*...> cols;
+    std::size_t num_rows;
+};
+} // namespace detail
+
+/**
+ * @brief Zip std::vector<bool> and std::bitset columns 64 rows at a time
+ *
+ * Each step binds one zippp::bit_word per column, so bitwise operations over all columns take one iteration per 64
+ * rows. As with zip, the rows run to the end of the shortest column. Use zip on the same columns for row by row
+ * access.
+ * ```
+ * for(auto&& [a, b, out] : zippp::zip_words(valid, deleted, mask))
+ * {
+ *     out = a & ~b;
+ * }
+ * ```
+ */
+template<typename ... Cols>
+detail::word_zip<Cols...> zip_words(Cols& ... cols)
+{
+    static_assert((detail::is_bit_column<std::remove_const_t<Cols>>::value && ...),
+        "zip_words only supports std::vector<bool> and std::bitset columns");
+    return detail::word_zip<Cols...>(cols...);
+}
+} // namespace zippp
+#endif
@@ -0,0 +1,387 @@
+#ifndef ZIPPP_COLUMNS
+#define ZIPPP_COLUMNS
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace zippp
+{
+namespace detail
+{
+/// Number of values an encoded column iterator decodes at once
+constexpr std::size_t decode_block_size = 64;
+
+/**
+ * @brief Forward iterator over an encoded column that decodes it one block at a time
+ *
+ * Iteration decodes decode_block_size values at a time into a buffer inside the iterator, so encoded columns can be
+ * zipped directly without unpacking them first. The Decoder holds the position in the encoded data and provides
+ * `void decode(T* out, std::size_t count)`, which decodes the next count values.
+ *
+ * Dereferencing returns the decoded value by copy, so bindings to it stay valid after the iterator moves on. This makes
+ * it a proxy iterator in the same way as the iterators of std::vector<bool>: it is tagged as a forward iterator, and
+ * copies can be iterated independently and repeatedly, but reference is not a T& as the C++17 forward iterator
+ * requirements ask. Algorithms that take the address of *it or keep references to elements cannot be used with it.
+ */
+template<typename T, typename Decoder>
+class block_decode_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = T;
+
+    block_decode_iterator() = default;
+    block_decode_iterator(Decoder decoder_, std::size_t pos_, std::size_t size_)
+        : decoder(decoder_), pos(pos_), size(size_)
+    {
+        fill();
+    }
+
+    reference operator*() const
+    {
+        return buffer[pos % decode_block_size];
+    }
+
+    block_decode_iterator& operator++()
+    {
+        if(++pos % decode_block_size == 0)
+        {
+            fill();
+        }
+        return *this;
+    }
+    block_decode_iterator operator++(int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    bool operator==(const block_decode_iterator& in) const
+    {
+        return pos == in.pos;
+    }
+    bool operator!=(const block_decode_iterator& in) const
+    {
+        return !(*this == in);
+    }
+
+private:
+    void fill()
+    {
+        if(pos < size)
+        {
+            decoder.decode(buffer.data(), std::min(decode_block_size, size - pos));
+        }
+    }
+
+    Decoder decoder;
+    std::size_t pos = 0;
+    std::size_t size = 0;
+    std::array<T, decode_block_size> buffer;
+};
+
+template<std::size_t Bits, typename T>
+struct bitpacked_decoder
+{
+    static constexpr std::uint64_t mask = Bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << Bits) - 1;
+
+    const std::uint64_t* words;
+
+    void decode(T* out, std::size_t count)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t bit = i * Bits;
+            const std::size_t word = bit / 64;
+            const std::size_t offset = bit % 64;
+            std::uint64_t value = words[word] >> offset;
+            if(offset + Bits > 64)
+            {
+                value |= words[word + 1] << (64 - offset);
+            }
+            out[i] = static_cast<T>(value & mask);
+        }
+        // Every full block takes exactly Bits words
+        words += Bits;
+    }
+};
+
+template<typename T>
+struct delta_decoder
+{
+    using unsigned_type = std::make_unsigned_t<T>;
+
+    const std::uint8_t* bytes;
+    T previous;
+
+    void decode(T* out, std::size_t count)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            std::uint64_t zigzag = 0;
+            for(unsigned shift = 0;; shift += 7)
+            {
+                const std::uint8_t byte = *bytes++;
+                zigzag |= std::uint64_t{byte & 0x7fu} << shift;
+                if(!(byte & 0x80u))
+                {
+                    break;
+                }
+            }
+            const std::uint64_t delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+            previous = static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(previous) + delta));
+            out[i] = previous;
+        }
+    }
+};
+
+/**
+ * @brief Random access iterator resolving dictionary codes in place
+ */
+template<typename T, typename Code>
+class dict_iterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    dict_iterator() = default;
+    dict_iterator(const T* dictionary_, const Code* code_) : dictionary(dictionary_), code(code_) {}
+
+    reference operator*() const { return dictionary[*code]; }
+    reference operator[](difference_type i) const { return dictionary[code[i]]; }
+
+    dict_iterator& operator++() { ++code; return *this; }
+    dict_iterator operator++(int) { auto temp = *this; ++code; return temp; }
+    dict_iterator& operator--() { --code; return *this; }
+    dict_iterator operator--(int) { auto temp = *this; --code; return temp; }
+    dict_iterator& operator+=(difference_type i) { code += i; return *this; }
+    dict_iterator& operator-=(difference_type i) { code -= i; return *this; }
+    dict_iterator operator+(difference_type i) const { return dict_iterator(dictionary, code + i); }
+    dict_iterator operator-(difference_type i) const { return dict_iterator(dictionary, code - i); }
+    difference_type operator-(const dict_iterator& in) const { return code - in.code; }
+
+    bool operator==(const dict_iterator& in) const { return code == in.code; }
+    bool operator!=(const dict_iterator& in) const { return code != in.code; }
+    bool operator<(const dict_iterator& in) const { return code < in.code; }
+    bool operator>(const dict_iterator& in) const { return code > in.code; }
+    bool operator<=(const dict_iterator& in) const { return code <= in.code; }
+    bool operator>=(const dict_iterator& in) const { return code >= in.code; }
+
+private:
+    const T* dictionary = nullptr;
+    const Code* code = nullptr;
+};
+} // namespace detail
+
+/**
+ * @brief Read only column of unsigned integers packed into Bits bits each
+ *
+ * Values are truncated to their lowest Bits bits when added. Every block of 64 values takes exactly Bits words, so
+ * values never need to be located through an index.
+ */
+template<std::size_t Bits, typename T = std::uint64_t>
+class bitpacked_column
+{
+    static_assert(Bits >= 1 && Bits <= 64, "Bits must be between 1 and 64");
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "bitpacked_column only holds unsigned integers");
+
+public:
+    using value_type = T;
+    using const_iterator = detail::block_decode_iterator<T, detail::bitpacked_decoder<Bits, T>>;
+    using iterator = const_iterator;
+
+    bitpacked_column() = default;
+    bitpacked_column(std::initializer_list<T> values) : bitpacked_column(values.begin(), values.end()) {}
+
+    template<typename Iter>
+    bitpacked_column(Iter first, Iter last)
+    {
+        for(; first != last; ++first)
+        {
+            push_back(static_cast<T>(*first));
+        }
+    }
+
+    void push_back(T value)
+    {
+        if(count % detail::decode_block_size == 0)
+        {
+            words.resize(words.size() + Bits, 0);
+        }
+        const std::uint64_t bits = static_cast<std::uint64_t>(value) & detail::bitpacked_decoder<Bits, T>::mask;
+        const std::size_t block = count / detail::decode_block_size;
+        const std::size_t bit = (count % detail::decode_block_size) * Bits;
+        const std::size_t word = block * Bits + bit / 64;
+        const std::size_t offset = bit % 64;
+        words[word] |= bits << offset;
+        if(offset + Bits > 64)
+        {
+            words[word + 1] |= bits >> (64 - offset);
+        }
+        ++count;
+    }
+
+    const_iterator begin() const { return const_iterator({words.data()}, 0, count); }
+    const_iterator end() const { return const_iterator({words.data()}, count, count); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    /// Size of the encoded data in bytes
+    std::size_t memory_bytes() const { return words.size() * sizeof(std::uint64_t); }
+
+private:
+    std::vector<std::uint64_t> words;
+    std::size_t count = 0;
+};
+
+/**
+ * @brief Read only column of integers stored as variable length differences between consecutive values
+ *
+ * Slowly changing values (timestamps, sorted ids, counters) take one or two bytes each. Differences are zigzag encoded
+ * into 7 bit groups, so both increasing and decreasing runs stay short.
+ */
+template<typename T>
+class delta_column
+{
+    static_assert(std::is_integral_v<T>, "delta_column only holds integers");
+    using unsigned_type = std::make_unsigned_t<T>;
+
+public:
+    using value_type = T;
+    using const_iterator = detail::block_decode_iterator<T, detail::delta_decoder<T>>;
+    using iterator = const_iterator;
+
+    delta_column() = default;
+    delta_column(std::initializer_list<T> values) : delta_column(values.begin(), values.end()) {}
+
+    template<typename Iter>
+    delta_column(Iter first, Iter last)
+    {
+        for(; first != last; ++first)
+        {
+            push_back(static_cast<T>(*first));
+        }
+    }
+
+    void push_back(T value)
+    {
+        // Wrap the difference into the width of T, then sign extend it so that zigzag encoding keeps it short
+        const auto diff = static_cast<unsigned_type>(static_cast<unsigned_type>(value) -
+                                                     static_cast<unsigned_type>(last));
+        const auto delta = static_cast<std::int64_t>(static_cast<std::make_signed_t<unsigned_type>>(diff));
+        std::uint64_t zigzag = (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+        while(zigzag >= 0x80)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(zigzag | 0x80));
+            zigzag >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(zigzag));
+        last = value;
+        ++count;
+    }
+
+    const_iterator begin() const { return const_iterator({bytes.data(), T{}}, 0, count); }
+    const_iterator end() const { return const_iterator({bytes.data(), T{}}, count, count); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    /// Size of the encoded data in bytes
+    std::size_t memory_bytes() const { return bytes.size(); }
+
+private:
+    std::vector<std::uint8_t> bytes;
+    T last{};
+    std::size_t count = 0;
+};
+
+/**
+ * @brief Read only column storing each distinct value once, and a Code per row indexing into them
+ *
+ * Decoding a row is a single lookup, so unlike the other encoded columns no block buffer is used. Iterators are random
+ * access and dereference to a reference into the dictionary, so large values are never copied.
+ *
+ * The column holds at most std::numeric_limits<Code>::max() + 1 distinct values, e.g. 256 with std::uint8_t codes.
+ */
+template<typename T, typename Code = std::uint32_t>
+class dict_column
+{
+    static_assert(std::is_integral_v<Code> && std::is_unsigned_v<Code>, "Code must be an unsigned integer");
+
+public:
+    using value_type = T;
+    using const_iterator = detail::dict_iterator<T, Code>;
+    using iterator = const_iterator;
+
+    dict_column() = default;
+    dict_column(std::initializer_list<T> values) : dict_column(values.begin(), values.end()) {}
+
+    /**
+     * @brief Encode the values, assigning codes in order of first appearance. T must be hashable.
+     *
+     * @throws std::length_error if there are more distinct values than Code can index
+     */
+    template<typename Iter>
+    dict_column(Iter first, Iter last)
+    {
+        std::unordered_map<T, Code> index;
+        for(; first != last; ++first)
+        {
+            auto found = index.find(*first);
+            if(found == index.end())
+            {
+                if(dict.size() > std::numeric_limits<Code>::max())
+                {
+                    throw std::length_error("dict_column: too many distinct values for the code type");
+                }
+                found = index.emplace(*first, static_cast<Code>(dict.size())).first;
+                dict.push_back(found->first);
+            }
+            codes.push_back(found->second);
+        }
+    }
+
+    /// Use an existing dictionary and codes. Every code must be a valid index into dictionary, which is asserted.
+    dict_column(std::vector<T> dictionary, std::vector<Code> codes_)
+        : dict(std::move(dictionary)), codes(std::move(codes_))
+    {
+#ifndef NDEBUG
+        for(const Code code : codes)
+        {
+            assert(code < dict.size() && "dict_column code out of range of the dictionary");
+        }
+#endif
+    }
+
+    const_iterator begin() const { return const_iterator(dict.data(), codes.data()); }
+    const_iterator end() const { return const_iterator(dict.data(), codes.data() + codes.size()); }
+
+    const T& operator[](std::size_t i) const { return dict[codes[i]]; }
+    std::size_t size() const { return codes.size(); }
+    bool empty() const { return codes.empty(); }
+    const std::vector<T>& dictionary() const { return dict; }
+    /// Size of the codes in bytes. The dictionary is not included.
+    std::size_t memory_bytes() const { return codes.size() * sizeof(Code); }
+
+private:
+    std::vector<T> dict;
+    std::vector<Code> codes;
+};
+} // namespace zippp
+#endif
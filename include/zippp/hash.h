@@ -0,0 +1,246 @@
+#ifndef ZIPPP_HASH
+#define ZIPPP_HASH
+#include "zippp/zip.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zippp
+{
+/**
+ * @brief Groups found by zippp::hash_aggregate
+ *
+ * Group g holds the rows with the same key as row rows[g], and values[g] is their aggregate. Groups are in order of
+ * their first row.
+ */
+template<typename Acc>
+struct aggregate_result
+{
+    std::vector<std::size_t> rows;
+    std::vector<Acc> values;
+};
+
+namespace detail
+{
+/// Rows whose keys are hashed together, one column at a time
+constexpr std::size_t hash_batch_size = 256;
+
+inline std::uint64_t hash_mix(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/// Hash of a single key. Arithmetic keys are hashed inline so the per column loops can vectorize
+template<typename T>
+inline std::uint64_t hash_value(const T& value)
+{
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+    {
+        return static_cast<std::uint64_t>(value);
+    }
+    else if constexpr (std::is_floating_point_v<T> && sizeof(T) <= sizeof(std::uint64_t))
+    {
+        // -0.0 and 0.0 compare equal, so they must hash the same
+        const T normalized = value == T{} ? T{} : value;
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &normalized, sizeof(T));
+        return bits;
+    }
+    else
+    {
+        return std::hash<T>{}(value);
+    }
+}
+
+/// Random access to the key columns of a zip by row index
+template<typename ... Iters>
+class key_columns
+{
+public:
+    explicit key_columns(Iters... iters_) : iters(iters_...)
+    {
+        static_assert((std::is_base_of_v<std::random_access_iterator_tag,
+                           typename std::iterator_traits<Iters>::iterator_category> && ...),
+            "Key columns must be random access");
+    }
+
+    /// Hash rows [first, first + count) into out
+    void hash_rows(std::size_t first, std::size_t count, std::uint64_t* out) const
+    {
+        std::fill(out, out + count, std::uint64_t(0x9e3779b97f4a7c15ULL));
+        std::apply([&](const auto& ... it) { (hash_column(it, first, count, out), ...); }, iters);
+    }
+
+    bool equal(std::size_t a, std::size_t b) const
+    {
+        return std::apply([&](const auto& ... it) { return ((it[a] == it[b]) && ...); }, iters);
+    }
+
+private:
+    template<typename Iter>
+    static void hash_column(const Iter& it, std::size_t first, std::size_t count, std::uint64_t* out)
+    {
+        // Only a multiply per column; the combined hash is mixed once all columns are in. Proxy references (as in
+        // std::vector<bool>) are converted to the value type, which is what std::hash is defined for
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+        const Iter base = it + first;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = (out[i] ^ hash_value(static_cast<value_type>(base[i]))) * 0x9e3779b97f4a7c15ULL;
+        }
+    }
+
+    std::tuple<Iters...> iters;
+};
+
+template<typename Keys>
+auto make_key_columns(Keys& keys)
+{
+    return std::apply([](auto& ... cols) {
+        using std::begin;
+        return key_columns<decltype(begin(cols))...>(begin(cols)...);
+    }, keys.columns());
+}
+
+/**
+ * @brief Open addressing table of groups
+ *
+ * The slots only hold group numbers and hashes; keys are compared through the row each group was first seen at, so
+ * no key is ever copied.
+ */
+class group_table
+{
+public:
+    /// The group of row, adding a new group if no earlier row had the same key
+    template<typename Equal>
+    std::pair<std::size_t, bool> find_or_insert(std::uint64_t hash, std::size_t row, const Equal& equal)
+    {
+        if((group_rows.size() + 1) * 2 > slots.size())
+        {
+            grow();
+        }
+        const std::size_t mask = slots.size() - 1;
+        for(std::size_t pos = hash & mask;; pos = (pos + 1) & mask)
+        {
+            slot& s = slots[pos];
+            if(s.group == 0)
+            {
+                s = slot{hash, group_rows.size() + 1};
+                group_rows.push_back(row);
+                return {group_rows.size() - 1, true};
+            }
+            if(s.hash == hash && equal(group_rows[s.group - 1], row))
+            {
+                return {s.group - 1, false};
+            }
+        }
+    }
+
+    std::vector<std::size_t>& rows()
+    {
+        return group_rows;
+    }
+
+private:
+    struct slot
+    {
+        std::uint64_t hash;
+        /// Group number + 1, 0 if the slot is empty
+        std::size_t group;
+    };
+
+    void grow()
+    {
+        std::vector<slot> old(std::max<std::size_t>(16, slots.size() * 2), slot{0, 0});
+        old.swap(slots);
+        const std::size_t mask = slots.size() - 1;
+        for(const slot& s : old)
+        {
+            if(s.group != 0)
+            {
+                std::size_t pos = s.hash & mask;
+                while(slots[pos].group != 0)
+                {
+                    pos = (pos + 1) & mask;
+                }
+                slots[pos] = s;
+            }
+        }
+    }
+
+    std::vector<slot> slots;
+    std::vector<std::size_t> group_rows;
+};
+
+/// Call on_row(row, group, is_new_group) for every row of keys, in order
+template<typename Keys, typename OnRow>
+void for_each_group(Keys& keys, group_table& table, OnRow&& on_row)
+{
+    const auto columns = make_key_columns(keys);
+    const auto equal = [&](std::size_t a, std::size_t b) { return columns.equal(a, b); };
+    const auto rows = static_cast<std::size_t>(std::distance(keys.begin(), keys.end()));
+    std::uint64_t hashes[hash_batch_size];
+    for(std::size_t first = 0; first < rows; first += hash_batch_size)
+    {
+        const std::size_t count = std::min(hash_batch_size, rows - first);
+        columns.hash_rows(first, count, hashes);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto [group, inserted] = table.find_or_insert(hash_mix(hashes[i]), first + i, equal);
+            on_row(first + i, group, inserted);
+        }
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Group the rows of a zip of key columns and aggregate a zip of value columns per group
+ *
+ * Rows with equal values in every key column form a group. For every row agg(acc, values...) is called with the
+ * accumulator of its group, which starts as a copy of init, and the row of each value column. This replaces an
+ * std::unordered_map keyed by a tuple of the key columns, without copying any keys: the table only stores row
+ * indices, and keys are compared in place.
+ *
+ * The key columns must be random access and their values equality comparable and hashable. The value zip must be at
+ * least as long as the key zip.
+ */
+template<typename Keys, typename Values, typename Agg, typename Acc>
+aggregate_result<Acc> hash_aggregate(Keys&& keys, Values&& values, Agg&& agg, Acc init)
+{
+    aggregate_result<Acc> result;
+    detail::group_table table;
+    auto value_it = values.begin();
+    detail::for_each_group(keys, table, [&](std::size_t, std::size_t group, bool inserted) {
+        if(inserted)
+        {
+            result.values.push_back(init);
+        }
+        Acc& acc = result.values[group];
+        detail::apply_value([&](auto&& ... value) { agg(acc, std::forward<decltype(value)>(value)...); },
+            *value_it);
+        ++value_it;
+    });
+    result.rows = std::move(table.rows());
+    return result;
+}
+
+/// Indices of the first row of every distinct key in a zip of key columns, in order
+template<typename Keys>
+std::vector<std::size_t> unique_rows(Keys&& keys)
+{
+    detail::group_table table;
+    detail::for_each_group(keys, table, [](std::size_t, std::size_t, bool) {});
+    return std::move(table.rows());
+}
+} // namespace zippp
+#endif
@@ -0,0 +1,134 @@
+#ifndef ZIPPP_PIPELINE
+#define ZIPPP_PIPELINE
+#include "zippp/zip.h"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace zippp
+{
+/// Default block size of pipeline::run(). Small enough for the rows of a block to stay in a typical L2 cache
+constexpr std::size_t default_pipeline_block_bytes = 256 * 1024;
+
+namespace detail
+{
+template<typename Tuple, std::size_t ... I>
+constexpr std::size_t row_bytes_impl(std::index_sequence<I...>)
+{
+    return (sizeof(zip_iter_types::value_type<std::tuple_element_t<I, Tuple>>) + ... + 0);
+}
+
+/// Bytes taken by one row of the zipped columns in Tuple
+template<typename Tuple>
+constexpr std::size_t row_bytes = row_bytes_impl<Tuple>(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+
+/// Move first at most n rows forward, without passing last
+template<typename Iter>
+Iter advance_bounded(Iter first, std::ptrdiff_t n, const Iter& last)
+{
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iter>::iterator_category>)
+    {
+        return first + std::min<std::ptrdiff_t>(n, last - first);
+    }
+    else
+    {
+        for(; n > 0 && first != last; --n)
+        {
+            ++first;
+        }
+        return first;
+    }
+}
+
+/**
+ * @brief A zip and the stages to run over it, built by zippp::pipeline()
+ *
+ * Zip is a reference when the pipeline was created from an lvalue zip, and the zip itself otherwise.
+ */
+template<typename Zip, typename ... Stages>
+class pipeline_impl
+{
+public:
+    pipeline_impl(Zip&& zip_, std::tuple<Stages...>&& stages_)
+        : zip(std::forward<Zip>(zip_)), stages(std::move(stages_)) {}
+
+    /// Append a stage. f is called with one argument per column, like the bindings of a range based for loop
+    template<typename F>
+    auto then(F&& f) const &
+    {
+        return pipeline_impl<Zip, Stages..., std::decay_t<F>>(
+            static_cast<Zip>(zip), std::tuple_cat(stages, std::make_tuple(std::forward<F>(f))));
+    }
+
+    template<typename F>
+    auto then(F&& f) &&
+    {
+        return pipeline_impl<Zip, Stages..., std::decay_t<F>>(
+            std::forward<Zip>(zip), std::tuple_cat(std::move(stages), std::make_tuple(std::forward<F>(f))));
+    }
+
+    /**
+     * @brief Run every stage over the zipped rows, one block of rows at a time
+     *
+     * All stages run over a block before the next block is started, so the later stages find its rows in cache.
+     * Within a block the stages run in the order they were added.
+     *
+     * @param block_bytes Target size of the rows of one block, summed over all columns. Always at least one row
+     */
+    void run(std::size_t block_bytes = default_pipeline_block_bytes)
+    {
+        using tuple_type = std::decay_t<decltype(zip.columns())>;
+        const auto rows_per_block = static_cast<std::ptrdiff_t>(
+            std::max<std::size_t>(1, block_bytes / std::max<std::size_t>(1, row_bytes<tuple_type>)));
+        auto first = zip.begin();
+        const auto last = zip.end();
+        while(first != last)
+        {
+            auto block_last = advance_bounded(first, rows_per_block, last);
+            run_block(zip_range<decltype(first)>(first, block_last), std::index_sequence_for<Stages...>{});
+            first = std::move(block_last);
+        }
+    }
+
+private:
+    template<typename Range, std::size_t ... I>
+    void run_block(const Range& block, std::index_sequence<I...>)
+    {
+        (run_stage(block, std::get<I>(stages)), ...);
+    }
+
+    template<typename Range, typename F>
+    static void run_stage(const Range& block, F& f)
+    {
+        for(auto it = block.begin(); it != block.end(); ++it)
+        {
+            apply_value(f, *it);
+        }
+    }
+
+    Zip zip;
+    std::tuple<Stages...> stages;
+};
+} // namespace detail
+
+/**
+ * @brief Fuse several passes over the same zipped columns into one cache blocked loop
+ *
+ * zippp::pipeline(zip(a, b, c)).then(f1).then(f2).run() has the same result as running f1 over all rows and then f2
+ * over all rows, as long as a stage only depends on rows the earlier stages have already processed (eg it does not
+ * need a total computed by an earlier stage). The rows are tiled into blocks that fit the cache, and every stage runs
+ * over a block before moving on to the next block, so the columns are only streamed from memory once.
+ *
+ * Lvalue zips are referenced, rvalue zips are moved into the pipeline.
+ */
+template<typename Zip>
+auto pipeline(Zip&& zip)
+{
+    return detail::pipeline_impl<Zip>(std::forward<Zip>(zip), std::tuple<>());
+}
+} // namespace zippp
+#endif
@@ -0,0 +1,444 @@
+#ifndef ZIPPP_SIMD
+#define ZIPPP_SIMD
+#include "zippp/zip.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__linux__)
+#define ZIPPP_SIMD_DISPATCH 1
+#endif
+
+#if defined(_MSC_VER)
+#define ZIPPP_SIMD_INLINE __forceinline
+#elif defined(__GNUC__)
+#define ZIPPP_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define ZIPPP_SIMD_INLINE inline
+#endif
+
+namespace zippp
+{
+/// Instruction sets simd_for_each can dispatch to, in increasing order of width
+enum class simd_isa
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512
+};
+
+/// The widest instruction set supported by both this build and the running CPU
+inline simd_isa detect_simd_isa()
+{
+#ifdef ZIPPP_SIMD_DISPATCH
+    static const simd_isa isa = [] {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+        {
+            return simd_isa::avx512;
+        }
+        if(__builtin_cpu_supports("avx2"))
+        {
+            return simd_isa::avx2;
+        }
+        if(__builtin_cpu_supports("sse2"))
+        {
+            return simd_isa::sse2;
+        }
+        return simd_isa::scalar;
+    }();
+    return isa;
+#else
+    return simd_isa::scalar;
+#endif
+}
+
+namespace detail
+{
+/// Storage of a pack. GCC and clang keep their vector extension types in registers, where a plain array would be
+/// spilled to the stack between every operation
+template<typename T, std::size_t N, typename = void>
+struct lane_storage
+{
+    using type = T[N];
+    static constexpr bool is_vector = false;
+};
+
+#if defined(__GNUC__)
+template<typename T, std::size_t N>
+struct lane_storage<T, N, std::enable_if_t<(N > 1) && std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+                                           && !std::is_same_v<T, long double>>>
+{
+    typedef T type __attribute__((vector_size(sizeof(T) * N)));
+    static constexpr bool is_vector = true;
+};
+#endif
+}
+
+/**
+ * @brief N values of one column, processed together in a single SIMD register
+ *
+ * All operations are compiled for the instruction set simd_for_each dispatched to, so a pack of the register width
+ * maps to single vector instructions.
+ */
+template<typename T, std::size_t N>
+struct lanes
+{
+    using value_type = T;
+    using storage_type = typename detail::lane_storage<T, N>::type;
+    static constexpr std::size_t width = N;
+
+    storage_type v;
+
+    lanes() = default;
+    ZIPPP_SIMD_INLINE lanes(T value)
+    {
+        if constexpr (detail::lane_storage<T, N>::is_vector)
+        {
+            v = storage_type{} + value;
+        }
+        else
+        {
+            for(std::size_t i = 0; i < N; ++i) v[i] = value;
+        }
+    }
+
+    ZIPPP_SIMD_INLINE T operator[](std::size_t i) const { return v[i]; }
+    ZIPPP_SIMD_INLINE void set(std::size_t i, T value) { v[i] = value; }
+
+    ZIPPP_SIMD_INLINE static lanes load(const T* p)
+    {
+        lanes r;
+        std::memcpy(&r.v, p, sizeof(r.v));
+        return r;
+    }
+    /// Load the first count values, setting the rest to T{}
+    ZIPPP_SIMD_INLINE static lanes load(const T* p, std::size_t count)
+    {
+        lanes r(T{});
+        std::memcpy(&r.v, p, count * sizeof(T));
+        return r;
+    }
+    ZIPPP_SIMD_INLINE void store(T* p) const
+    {
+        std::memcpy(p, &v, sizeof(v));
+    }
+    /// Store only the first count values
+    ZIPPP_SIMD_INLINE void store(T* p, std::size_t count) const
+    {
+        std::memcpy(p, &v, count * sizeof(T));
+    }
+
+#define ZIPPP_LANES_OP(op) \
+    ZIPPP_SIMD_INLINE lanes& operator op##=(const lanes& in) \
+    { \
+        if constexpr (detail::lane_storage<T, N>::is_vector) \
+        { \
+            v op##= in.v; \
+        } \
+        else \
+        { \
+            for(std::size_t i = 0; i < N; ++i) v[i] op##= in.v[i]; \
+        } \
+        return *this; \
+    } \
+    ZIPPP_SIMD_INLINE friend lanes operator op(const lanes& a, const lanes& b) { return lanes(a) op##= b; } \
+    ZIPPP_SIMD_INLINE friend lanes operator op(const lanes& a, T b) { return lanes(a) op##= lanes(b); } \
+    ZIPPP_SIMD_INLINE friend lanes operator op(T a, const lanes& b) { return lanes(a) op##= b; }
+
+    ZIPPP_LANES_OP(+)
+    ZIPPP_LANES_OP(-)
+    ZIPPP_LANES_OP(*)
+#undef ZIPPP_LANES_OP
+
+    /// Integer lanes divided by zero give zero, as the inactive lanes of a partial pack are zero
+    ZIPPP_SIMD_INLINE lanes& operator/=(const lanes& in)
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            for(std::size_t i = 0; i < N; ++i) v[i] = in.v[i] == 0 ? T{} : static_cast<T>(v[i] / in.v[i]);
+        }
+        else if constexpr (detail::lane_storage<T, N>::is_vector)
+        {
+            v /= in.v;
+        }
+        else
+        {
+            for(std::size_t i = 0; i < N; ++i) v[i] /= in.v[i];
+        }
+        return *this;
+    }
+    ZIPPP_SIMD_INLINE friend lanes operator/(const lanes& a, const lanes& b) { return lanes(a) /= b; }
+    ZIPPP_SIMD_INLINE friend lanes operator/(const lanes& a, T b) { return lanes(a) /= lanes(b); }
+    ZIPPP_SIMD_INLINE friend lanes operator/(T a, const lanes& b) { return lanes(a) /= b; }
+
+    ZIPPP_SIMD_INLINE lanes operator-() const
+    {
+        return lanes(T{}) -= *this;
+    }
+
+    ZIPPP_SIMD_INLINE T sum() const
+    {
+        T r = v[0];
+        for(std::size_t i = 1; i < N; ++i) r += v[i];
+        return r;
+    }
+    ZIPPP_SIMD_INLINE T min() const
+    {
+        T r = v[0];
+        for(std::size_t i = 1; i < N; ++i) r = v[i] < r ? v[i] : r;
+        return r;
+    }
+    ZIPPP_SIMD_INLINE T max() const
+    {
+        T r = v[0];
+        for(std::size_t i = 1; i < N; ++i) r = r < v[i] ? v[i] : r;
+        return r;
+    }
+};
+
+/// Convert every lane to U
+template<typename U, typename T, std::size_t N>
+ZIPPP_SIMD_INLINE lanes<U, N> lanes_cast(const lanes<T, N>& in)
+{
+    lanes<U, N> r;
+#if defined(__GNUC__)
+    // The builtin takes a type as an argument, so other compilers cannot even parse it in a discarded branch
+    if constexpr (detail::lane_storage<T, N>::is_vector && detail::lane_storage<U, N>::is_vector)
+    {
+        r.v = __builtin_convertvector(in.v, typename lanes<U, N>::storage_type);
+    }
+    else
+#endif
+    {
+        for(std::size_t i = 0; i < N; ++i) r.v[i] = static_cast<U>(in.v[i]);
+    }
+    return r;
+}
+
+/// Which lanes of a call hold actual rows. Only the first `active` lanes do
+template<std::size_t N>
+struct lane_mask
+{
+    static constexpr std::size_t width = N;
+    std::size_t active;
+
+    constexpr bool operator[](std::size_t i) const { return i < active; }
+    constexpr bool all() const { return active == N; }
+};
+
+/// Replace the inactive lanes with fill
+template<typename T, std::size_t N>
+ZIPPP_SIMD_INLINE lanes<T, N> masked(const lane_mask<N>& mask, const lanes<T, N>& values, T fill = T{})
+{
+    lanes<T, N> r = values;
+    for(std::size_t i = mask.active; i < N; ++i) r.set(i, fill);
+    return r;
+}
+
+namespace detail
+{
+template<typename Ptr>
+using pointee_t = std::remove_const_t<std::remove_pointer_t<Ptr>>;
+
+/// Lanes per call: as many as fit the widest column into one register of RegBytes
+template<std::size_t RegBytes, typename ... Ptrs>
+constexpr std::size_t lane_count = std::max<std::size_t>(1, RegBytes / std::max({sizeof(pointee_t<Ptrs>)...}));
+
+/// Packs of read only columns are passed to f as const
+template<typename Ptr, typename Pack>
+ZIPPP_SIMD_INLINE auto& pack_arg(Pack& pack)
+{
+    if constexpr (std::is_const_v<std::remove_pointer_t<Ptr>>)
+    {
+        return std::as_const(pack);
+    }
+    else
+    {
+        return pack;
+    }
+}
+
+template<std::size_t N, typename F, typename ... Packs>
+ZIPPP_SIMD_INLINE void invoke_lanes(F& f, std::size_t count, Packs& ... packs)
+{
+    if constexpr (std::is_invocable_v<F&, lane_mask<N>, Packs&...>)
+    {
+        f(lane_mask<N>{count}, packs...);
+    }
+    else
+    {
+        f(packs...);
+    }
+}
+
+template<typename Pack, typename Ptr>
+ZIPPP_SIMD_INLINE void store_pack(const Pack& pack, Ptr ptr, std::size_t count)
+{
+    if constexpr (!std::is_const_v<std::remove_pointer_t<Ptr>>)
+    {
+        if(Pack::width == 1 || count == Pack::width)
+        {
+            pack.store(ptr);
+        }
+        else
+        {
+            pack.store(ptr, count);
+        }
+    }
+}
+
+/// One column's pack. Packs are held as bases of pack_set rather than in an std::tuple, as the helpers of std::tuple
+/// are not always inlined into the target specific kernels
+template<std::size_t I, typename Pack>
+struct pack_slot
+{
+    Pack pack;
+};
+
+template<std::size_t N, typename Seq, typename ... Ptrs>
+struct pack_set;
+
+template<std::size_t N, std::size_t ... I, typename ... Ptrs>
+struct pack_set<N, std::index_sequence<I...>, Ptrs...> : pack_slot<I, lanes<pointee_t<Ptrs>, N>>...
+{
+};
+
+template<std::size_t I, typename Pack>
+ZIPPP_SIMD_INLINE Pack& get_pack(pack_slot<I, Pack>& slot)
+{
+    return slot.pack;
+}
+
+/// Load count rows into a pack per column, call f, and write back the packs of the writable columns
+template<std::size_t N, typename F, std::size_t ... I, typename ... Ptrs>
+ZIPPP_SIMD_INLINE void simd_step(F& f, std::index_sequence<I...> seq, std::size_t offset, std::size_t count,
+                                 Ptrs ... ptrs)
+{
+    pack_set<N, decltype(seq), Ptrs...> packs;
+    // Packs of a single lane are never partial
+    ((get_pack<I>(packs) = N == 1 || count == N ? lanes<pointee_t<Ptrs>, N>::load(ptrs + offset)
+                                                : lanes<pointee_t<Ptrs>, N>::load(ptrs + offset, count)), ...);
+    invoke_lanes<N>(f, count, pack_arg<Ptrs>(get_pack<I>(packs))...);
+    (store_pack(get_pack<I>(packs), ptrs + offset, count), ...);
+}
+
+template<std::size_t RegBytes, typename F, typename First, typename ... Ptrs>
+ZIPPP_SIMD_INLINE void simd_kernel(F& f, std::size_t rows, First first, Ptrs ... ptrs)
+{
+    constexpr std::size_t N = lane_count<RegBytes, First, Ptrs...>;
+    constexpr auto seq = std::index_sequence_for<First, Ptrs...>{};
+    constexpr std::size_t pack_bytes = N * sizeof(pointee_t<First>);
+    // Peel rows until the first column is aligned to a whole pack, so its loads and stores do not split cache lines
+    const auto address = reinterpret_cast<std::uintptr_t>(first);
+    std::size_t count = N;
+    if(N > 1 && address % sizeof(pointee_t<First>) == 0 && address % pack_bytes != 0)
+    {
+        count = (pack_bytes - address % pack_bytes) / sizeof(pointee_t<First>);
+    }
+    // f is called from a single place, which keeps it small enough to be inlined into the target specific kernels
+    for(std::size_t i = 0; i < rows; i += count, count = N)
+    {
+        simd_step<N>(f, seq, i, std::min(count, rows - i), first, ptrs...);
+    }
+}
+
+template<typename F, typename ... Ptrs>
+void simd_run_scalar(F& f, std::size_t rows, Ptrs ... ptrs)
+{
+    simd_kernel<1>(f, rows, ptrs...);
+}
+
+#ifdef ZIPPP_SIMD_DISPATCH
+// flatten inlines f and the lanes operations, so they are compiled for the target of each dispatch function
+template<typename F, typename ... Ptrs>
+__attribute__((target("sse2"), flatten)) void simd_run_sse2(F& f, std::size_t rows, Ptrs ... ptrs)
+{
+    simd_kernel<16>(f, rows, ptrs...);
+}
+
+template<typename F, typename ... Ptrs>
+__attribute__((target("avx2"), flatten)) void simd_run_avx2(F& f, std::size_t rows, Ptrs ... ptrs)
+{
+    simd_kernel<32>(f, rows, ptrs...);
+}
+
+template<typename F, typename ... Ptrs>
+__attribute__((target("avx512f"), flatten)) void simd_run_avx512(F& f, std::size_t rows, Ptrs ... ptrs)
+{
+    simd_kernel<64>(f, rows, ptrs...);
+}
+#endif
+
+template<typename F, typename ... Ptrs>
+void simd_dispatch(simd_isa isa, F& f, std::size_t rows, Ptrs ... ptrs)
+{
+    static_assert((std::is_arithmetic_v<pointee_t<Ptrs>> && ...), "simd_for_each only supports arithmetic columns");
+#ifdef ZIPPP_SIMD_DISPATCH
+    switch(std::min(isa, detect_simd_isa()))
+    {
+    case simd_isa::avx512:
+        return simd_run_avx512(f, rows, ptrs...);
+    case simd_isa::avx2:
+        return simd_run_avx2(f, rows, ptrs...);
+    case simd_isa::sse2:
+        return simd_run_sse2(f, rows, ptrs...);
+    case simd_isa::scalar:
+        break;
+    }
+#else
+    (void)isa;
+#endif
+    simd_run_scalar(f, rows, ptrs...);
+}
+} // namespace detail
+
+/**
+ * @brief Calls f with packs of consecutive rows, one zippp::lanes per column
+ *
+ * Every zipped collection must be contiguous (std::data() and std::size() must work on it) and hold arithmetic values.
+ * The number of lanes depends on the instruction set selected at runtime, so f should be a generic lambda.
+ * Packs of writable columns are passed by non-const reference and written back after each call. Zip a const view of
+ * a column (eg std::as_const) to pass it by const reference and skip the write back.
+ *
+ * The rows before the first column is aligned and the rows after the last full pack are processed with packs padded
+ * with T{}. If f accepts a zippp::lane_mask as its first argument it is told which lanes are real rows.
+ *
+ * @param isa Widest instruction set to use. Narrower sets are used if the CPU does not support it
+ */
+template<typename Zip, typename F>
+void simd_for_each(simd_isa isa, Zip&& zip, F&& f)
+{
+    constexpr bool is_const = std::is_const_v<std::remove_reference_t<Zip>>;
+    std::apply([&](auto&... cols) {
+        const std::size_t rows = std::size(std::get<0>(std::forward_as_tuple(cols...)));
+        auto ptr = [](auto& col) {
+            using std::data;
+            auto p = data(col);
+            if constexpr (is_const)
+            {
+                return static_cast<const std::remove_pointer_t<decltype(p)>*>(p);
+            }
+            else
+            {
+                return p;
+            }
+        };
+        detail::simd_dispatch(isa, f, rows, ptr(cols)...);
+    }, zip.columns());
+}
+
+/// simd_for_each using the widest instruction set the CPU supports
+template<typename Zip, typename F>
+void simd_for_each(Zip&& zip, F&& f)
+{
+    simd_for_each(detect_simd_isa(), std::forward<Zip>(zip), std::forward<F>(f));
+}
+} // namespace zippp
+#endif
@@ -0,0 +1,243 @@
+#ifndef ZIPPP_TRANSFORM
+#define ZIPPP_TRANSFORM
+#include "zippp/zip.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZIPPP_HAS_STREAM_STORES 1
+#endif
+
+namespace zippp
+{
+/**
+ * @brief How transform_into writes results into the output columns
+ */
+enum class store_policy
+{
+    /// Plain assignment through the output bindings
+    normal,
+    /// Non-temporal stores for 4 and 8 byte trivially copyable outputs, so large outputs bypass the cache and do not
+    /// evict the input columns. Falls back to plain assignment for any other output, or on non x86 targets.
+    streaming
+};
+
+namespace detail
+{
+
+template<typename T, typename = void>
+struct is_tuple_like : std::false_type {};
+
+template<typename T>
+struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type {};
+
+/// Store value into dst, using a non-temporal store if the target and type allow it
+template<store_policy Store, typename T, typename V>
+inline void store_value(T& dst, V&& value)
+{
+#ifdef ZIPPP_HAS_STREAM_STORES
+    if constexpr (Store == store_policy::streaming && std::is_trivially_copyable_v<T> && sizeof(T) == 4)
+    {
+        const T tmp = std::forward<V>(value);
+        int bits;
+        std::memcpy(&bits, &tmp, sizeof(bits));
+        _mm_stream_si32(reinterpret_cast<int*>(std::addressof(dst)), bits);
+        return;
+    }
+#if defined(__x86_64__) || defined(_M_X64)
+    if constexpr (Store == store_policy::streaming && std::is_trivially_copyable_v<T> && sizeof(T) == 8)
+    {
+        const T tmp = std::forward<V>(value);
+        long long bits;
+        std::memcpy(&bits, &tmp, sizeof(bits));
+        _mm_stream_si64(reinterpret_cast<long long*>(std::addressof(dst)), bits);
+        return;
+    }
+#endif
+#endif
+    dst = std::forward<V>(value);
+}
+
+/// Assign a single result into the output binding. Proxy references (eg std::vector<bool>) are always assigned.
+template<store_policy Store, typename Ref, typename V>
+inline void store_element(Ref&& dst, V&& value)
+{
+    if constexpr (std::is_lvalue_reference_v<Ref>)
+    {
+        store_value<Store>(dst, std::forward<V>(value));
+    }
+    else
+    {
+        dst = std::forward<V>(value);
+    }
+}
+
+template<store_policy Store, typename Out, typename Result, std::size_t ... I>
+inline void scatter_impl(Out& out, Result&& result, std::index_sequence<I...>)
+{
+    using std::get;
+    (store_element<Store>(out.template get<I>(), get<I>(std::forward<Result>(result))), ...);
+}
+
+/// Write the result of the transform into each of the output columns
+template<store_policy Store, typename ... Iters, typename Result>
+inline void scatter(zip_iter_value<Iters...>& out, Result&& result)
+{
+    using result_type = std::decay_t<Result>;
+    if constexpr (sizeof...(Iters) == 1 && !is_tuple_like<result_type>::value)
+    {
+        store_element<Store>(out.template get<0>(), std::forward<Result>(result));
+    }
+    else if constexpr (sizeof...(Iters) == 1 && std::tuple_size<result_type>::value != 1)
+    {
+        // A tuple-like value (eg a std::pair) being written to a single column of that type
+        store_element<Store>(out.template get<0>(), std::forward<Result>(result));
+    }
+    else
+    {
+        static_assert(std::tuple_size<result_type>::value == sizeof...(Iters),
+            "Transform must return one value per output column");
+        scatter_impl<Store>(out, std::forward<Result>(result), std::index_sequence_for<Iters...>{});
+    }
+}
+
+/// Order any non-temporal stores before anything that follows
+inline void store_fence()
+{
+#ifdef ZIPPP_HAS_STREAM_STORES
+    _mm_sfence();
+#endif
+}
+
+/// Joins all started threads on destruction, so a thread failing to start does not terminate the ones already running
+class join_guard
+{
+public:
+    explicit join_guard(std::vector<std::thread>& threads_) : threads(threads_) {}
+    join_guard(const join_guard&) = delete;
+    join_guard& operator=(const join_guard&) = delete;
+
+    ~join_guard()
+    {
+        for(auto& t : threads)
+        {
+            if(t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+private:
+    std::vector<std::thread>& threads;
+};
+
+template<store_policy Store, typename InIter, typename OutIter, typename F>
+inline void transform_range(InIter first, InIter last, OutIter out, F& f)
+{
+    for(; first != last; ++first, ++out)
+    {
+        scatter<Store>(*out, apply_value(f, *first));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Applies f to every row of the input zip and writes the results into the rows of the output zip
+ *
+ * @param in Zipped input columns. Each row is passed to f as one argument per column
+ * @param out Zipped output columns. Must be at least as long as in
+ * @param f Callable returning a tuple-like value with one element per output column. If there is only one output
+ *          column f may return the value directly
+ *
+ * Setting Store to store_policy::streaming writes the outputs with non-temporal stores. This is only worthwhile when
+ * the outputs are much larger than the cache and will not be read again soon.
+ */
+template<store_policy Store = store_policy::normal, typename In, typename Out, typename F>
+void transform_into(In&& in, Out&& out, F&& f)
+{
+    detail::transform_range<Store>(in.begin(), in.end(), out.begin(), f);
+    if constexpr (Store == store_policy::streaming)
+    {
+        detail::store_fence();
+    }
+}
+
+/**
+ * @brief Parallel version of transform_into
+ *
+ * The rows are split into contiguous chunks, each processed by its own thread. f is invoked concurrently and must be
+ * safe to call from multiple threads. Both zips must be random access. If f throws, the first exception is rethrown
+ * once all threads have finished.
+ *
+ * @param num_threads Number of threads to use. 0 uses std::thread::hardware_concurrency()
+ */
+template<store_policy Store = store_policy::normal, typename In, typename Out, typename F>
+void parallel_transform_into(In&& in, Out&& out, F&& f, std::size_t num_threads = 0)
+{
+    auto first = in.begin();
+    auto out_first = out.begin();
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                      typename std::iterator_traits<decltype(first)>::iterator_category>,
+        "parallel_transform_into requires random access input columns");
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                      typename std::iterator_traits<decltype(out_first)>::iterator_category>,
+        "parallel_transform_into requires random access output columns");
+
+    // Chunks are whole multiples of 64 rows. Chunk boundaries then fall on 64 bit words of bit columns, and on cache
+    // lines of outputs whose data is itself cache line aligned; other outputs share at most a line per boundary
+    constexpr std::ptrdiff_t chunk_align = 64;
+    const std::ptrdiff_t rows = in.end() - first;
+    if(num_threads == 0)
+    {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::ptrdiff_t max_chunks = (rows + chunk_align - 1) / chunk_align;
+    const std::ptrdiff_t chunks = std::max<std::ptrdiff_t>(1, std::min<std::ptrdiff_t>(num_threads, max_chunks));
+    const std::ptrdiff_t chunk = ((rows / chunks + chunk_align - 1) / chunk_align) * chunk_align;
+
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run_chunk = [&](std::ptrdiff_t c) {
+        const std::ptrdiff_t begin = std::min(rows, c * chunk);
+        const std::ptrdiff_t end = c + 1 == chunks ? rows : std::min(rows, begin + chunk);
+        try
+        {
+            detail::transform_range<Store>(first + begin, first + end, out_first + begin, f);
+            if constexpr (Store == store_policy::streaming)
+            {
+                detail::store_fence();
+            }
+        }
+        catch(...)
+        {
+            errors[c] = std::current_exception();
+        }
+    };
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(chunks - 1);
+        detail::join_guard joiner(threads);
+        for(std::ptrdiff_t c = 0; c + 1 < chunks; ++c)
+        {
+            threads.emplace_back(run_chunk, c);
+        }
+        run_chunk(chunks - 1);
+    }
+    for(auto& e : errors)
+    {
+        if(e)
+        {
+            std::rethrow_exception(e);
+        }
+    }
+}
+} // namespace zippp
+#endif
@@ -2,11 +2,107 @@
 #define ZIPPP
 #include <type_traits>
 #include <tuple>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
+#ifdef ZIPPP_ENABLE_CHECKS
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#ifndef ZIPPP_CHECK_FAILED
+/// Called with a description of the misuse when a check fails. Define it before including zippp to throw or log instead
+#define ZIPPP_CHECK_FAILED(message) (std::fprintf(stderr, "zippp check failed: %s\n", message), std::abort())
+#endif
+#endif
+
+#ifdef ZIPPP_ENABLE_INSTRUMENTATION
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define ZIPPP_HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ZIPPP_HAS_RDTSC 1
+#endif
+#endif
 
 namespace zippp
 {
+/**
+ * @brief Statistics for a single pass over an instrumented zip
+ *
+ * A pass starts when begin() is called on the collection and ends when an iterator compares equal to end(), or when the
+ * collection is destroyed.
+ */
+struct zip_loop_stats
+{
+    /// Number of times the iterators were incremented
+    std::size_t elements;
+    /// Number of zipped collections
+    std::size_t columns;
+    /// Sum of the element sizes of every collection
+    std::size_t row_bytes;
+    /// Bytes of each collection covered by the pass. Points at `columns` entries, only valid during the report
+    const std::size_t* column_bytes;
+    /// Wall clock time of the pass
+    std::chrono::nanoseconds wall_time;
+    /// Time stamp counter ticks for the pass, or 0 if the target does not have one
+    std::uint64_t cycles;
+};
+
+/// Function receiving the stats of each finished pass
+using instrumentation_sink = void(*)(const zip_loop_stats&);
+
 namespace detail
 {
+inline std::atomic<instrumentation_sink>& instrumentation_sink_slot()
+{
+    static std::atomic<instrumentation_sink> sink{nullptr};
+    return sink;
+}
+} // namespace detail
+
+/// Set the sink used by zippp::instrumented. Passing nullptr discards all reports
+inline void set_instrumentation_sink(instrumentation_sink sink)
+{
+    detail::instrumentation_sink_slot().store(sink);
+}
+
+/// Sink that forwards the reports to the function installed with set_instrumentation_sink()
+struct default_instrumentation_sink
+{
+    static void report(const zip_loop_stats& stats)
+    {
+        if(auto sink = detail::instrumentation_sink_slot().load())
+        {
+            sink(stats);
+        }
+    }
+};
+
+/**
+ * @brief Zip policy that reports loop statistics to Sink
+ *
+ * Sink must provide `static void report(const zip_loop_stats&)`. The policy only has an effect when
+ * ZIPPP_ENABLE_INSTRUMENTATION is defined, otherwise `zip<basic_instrumented<Sink>>()` is exactly `zip()`.
+ * The macro must be set the same way in every translation unit of a program.
+ */
+template<typename Sink>
+struct basic_instrumented {};
+
+/// Instrumentation policy reporting to the sink set with set_instrumentation_sink()
+using instrumented = basic_instrumented<default_instrumentation_sink>;
+
+namespace detail
+{
+template<typename T>
+struct is_zip_policy : std::false_type {};
+
+template<typename Sink>
+struct is_zip_policy<basic_instrumented<Sink>> : std::true_type {};
 
 template<typename Base, typename ... Types>
 constexpr inline bool all_are_type()
@@ -71,6 +167,154 @@ public:
     }
 };
 
+/// Invoke f with every element of a zip_iter_value, as if it had been bound to a structured binding of references
+template<typename F, typename Value, std::size_t ... I>
+constexpr decltype(auto) apply_value_impl(F&& f, Value& value, std::index_sequence<I...>)
+{
+    return std::forward<F>(f)(value.template get<I>()...);
+}
+
+template<typename F, typename ... Iters>
+constexpr decltype(auto) apply_value(F&& f, zip_iter_value<Iters...>& value)
+{
+    return apply_value_impl(std::forward<F>(f), value, std::index_sequence_for<Iters...>{});
+}
+
+#ifdef ZIPPP_ENABLE_CHECKS
+template<typename T, typename = void>
+struct has_size : std::false_type {};
+
+template<typename T>
+struct has_size<T, std::void_t<decltype(std::size(std::declval<const T&>()))>> : std::true_type {};
+
+template<typename T, typename = void>
+struct has_data : std::false_type {};
+
+template<typename T>
+struct has_data<T, std::void_t<decltype(std::data(std::declval<const T&>()))>> : std::true_type {};
+
+/// True if the elements can be assigned through the iterator
+template<typename Iter>
+constexpr bool is_writable_iter = std::is_lvalue_reference_v<typename std::iterator_traits<Iter>::reference>
+    && !std::is_const_v<std::remove_reference_t<typename std::iterator_traits<Iter>::reference>>;
+
+/**
+ * @brief State shared by the iterators of a zip when ZIPPP_ENABLE_CHECKS is defined
+ *
+ * Created by zip_collection::begin() and end(), which check that no two writable contiguous collections overlap. The
+ * iterators then check on every move and dereference that the collections still have the same lengths and that none
+ * has been reallocated. Collections may still grow together, as long as their iterators stay valid.
+ */
+class zip_checks
+{
+public:
+    virtual ~zip_checks() = default;
+    virtual void verify() const = 0;
+};
+
+template<typename ... Cols>
+class zip_checks_for : public zip_checks
+{
+public:
+    zip_checks_for(const std::array<bool, sizeof...(Cols)>& writable, const Cols& ... cols_) : cols(&cols_...)
+    {
+        record(std::index_sequence_for<Cols...>{});
+        check_lengths();
+        for(std::size_t i = 0; i < sizeof...(Cols); ++i)
+        {
+            for(std::size_t j = 0; j < i; ++j)
+            {
+                if(writable[i] && writable[j] && data_begin[i] < data_end[j] && data_begin[j] < data_end[i])
+                {
+                    ZIPPP_CHECK_FAILED("writable zipped collections overlap");
+                }
+            }
+        }
+    }
+
+    void verify() const override
+    {
+        check_data(std::index_sequence_for<Cols...>{});
+        check_lengths();
+    }
+
+private:
+    template<std::size_t ... I>
+    void record(std::index_sequence<I...>)
+    {
+        (record_column<I>(), ...);
+    }
+
+    template<std::size_t I>
+    void record_column()
+    {
+        const auto& col = *std::get<I>(cols);
+        using col_type = std::tuple_element_t<I, std::tuple<Cols...>>;
+        if constexpr (has_data<col_type>::value && has_size<col_type>::value)
+        {
+            data[I] = std::data(col);
+            data_begin[I] = reinterpret_cast<std::uintptr_t>(std::data(col));
+            data_end[I] = reinterpret_cast<std::uintptr_t>(std::data(col) + std::size(col));
+        }
+    }
+
+    template<std::size_t ... I>
+    void check_data(std::index_sequence<I...>) const
+    {
+        (check_column_data<I>(), ...);
+    }
+
+    template<std::size_t I>
+    void check_column_data() const
+    {
+        using col_type = std::tuple_element_t<I, std::tuple<Cols...>>;
+        if constexpr (has_data<col_type>::value && has_size<col_type>::value)
+        {
+            if(static_cast<const void*>(std::data(*std::get<I>(cols))) != data[I])
+            {
+                ZIPPP_CHECK_FAILED("a zipped collection was reallocated during iteration");
+            }
+        }
+    }
+
+    /// Collections without a size() are not checked
+    void check_lengths() const
+    {
+        std::apply([](const auto* ... col) {
+            std::size_t length = 0;
+            bool first = true;
+            const auto check = [&](const auto* c) {
+                if constexpr (has_size<std::remove_cv_t<std::remove_pointer_t<decltype(c)>>>::value)
+                {
+                    const auto size = static_cast<std::size_t>(std::size(*c));
+                    if(!first && size != length)
+                    {
+                        ZIPPP_CHECK_FAILED("zipped collections have different lengths");
+                    }
+                    length = size;
+                    first = false;
+                }
+            };
+            (check(col), ...);
+        }, cols);
+    }
+
+    std::tuple<const Cols*...> cols;
+    std::array<const void*, sizeof...(Cols)> data{};
+    std::array<std::uintptr_t, sizeof...(Cols)> data_begin{};
+    std::array<std::uintptr_t, sizeof...(Cols)> data_end{};
+};
+
+template<typename Iter>
+struct writable_columns;
+
+template<typename Seq, typename ... Iters>
+struct writable_columns<zip_iterator<Seq, Iters...>>
+{
+    static constexpr std::array<bool, sizeof...(Iters)> value{is_writable_iter<Iters>...};
+};
+#endif
+
 /**
  * @brief The iterator for a zipped set of collections
  * 
@@ -105,6 +349,7 @@ public:
     // Increment operators
     decltype(auto) operator++()
     {
+        verify_collections();
         ((void)++std::get<Ind>(iter_values.iters), ...);
         return *this;
     }
@@ -118,6 +363,7 @@ public:
     // Dereference operators
     reference operator*()
     {
+        verify_collections();
         return iter_values;
     }
 
@@ -135,6 +381,7 @@ public:
     template<typename T = std::bidirectional_iterator_tag, typename X = IterEnabler<T>>
     decltype(auto) operator--()
     {
+        verify_collections();
         ((void)--std::get<Ind>(iter_values.iters), ...);
         return *this;
     }
@@ -150,6 +397,7 @@ public:
     template<typename T = std::random_access_iterator_tag, typename X = IterEnabler<T>>
     decltype(auto) operator+=(ptrdiff_t i)
     {
+        verify_collections();
         (((void)(std::get<Ind>(iter_values.iters) += i)), ...);
         return *this;
     }
@@ -163,6 +411,7 @@ public:
     template<typename T = std::random_access_iterator_tag, typename X = IterEnabler<T>>
     decltype(auto) operator-=(ptrdiff_t i)
     {
+        verify_collections();
         (((void)(std::get<Ind>(iter_values.iters) -= i)), ...);
         return *this;
     }
@@ -173,12 +422,52 @@ public:
         temp -= i;
         return temp;
     }
+    template<typename T = std::random_access_iterator_tag, typename X = IterEnabler<T>>
+    difference_type operator-(const zip_iterator<std::index_sequence<Ind...>, Iters...>& in) const
+    {
+        return std::get<0>(iter_values.iters) - std::get<0>(in.iter_values.iters);
+    }
+
+    /// Iterator moving in the opposite direction over the same collections.
+    /// Like std::reverse_iterator, it dereferences to the element before the current position
+    template<typename T = std::bidirectional_iterator_tag, typename X = IterEnabler<T>>
+    auto reversed() const
+    {
+        auto result = zip_iterator<std::index_sequence<Ind...>, std::reverse_iterator<Iters>...>(
+            std::make_reverse_iterator(std::get<Ind>(iter_values.iters))...);
+#ifdef ZIPPP_ENABLE_CHECKS
+        result.attach_checks(checks);
+#endif
+        return result;
+    }
+
+#ifdef ZIPPP_ENABLE_CHECKS
+    /// Share the checks of the pass this iterator belongs to. Set by zip_collection on begin() and end()
+    void attach_checks(std::shared_ptr<const zip_checks> checks_)
+    {
+        checks = std::move(checks_);
+    }
+#endif
 
 private:
+    /// Fail if the collections were reallocated or changed to different lengths. Compiles to nothing unless ZIPPP_ENABLE_CHECKS is defined
+    void verify_collections() const
+    {
+#ifdef ZIPPP_ENABLE_CHECKS
+        if(checks)
+        {
+            checks->verify();
+        }
+#endif
+    }
+
     // The actual iterators are stored inside this object
     // Keep the values here so that we can return lvalue references to it
     zip_iter_value<Iters...> iter_values;
 
+#ifdef ZIPPP_ENABLE_CHECKS
+    std::shared_ptr<const zip_checks> checks;
+#endif
 };
 
 /// Using begin to allow for ADL
@@ -192,9 +481,85 @@ using iterator = zip_iterator<std::make_index_sequence<sizeof...(Collections)>,
 template<typename ... Collections>
 using const_iterator = zip_iterator<std::make_index_sequence<sizeof...(Collections)>, 
                                     decltype(cbegin(std::declval<Collections>()))...>;
+template<typename Collection>
+using value_type = typename std::iterator_traits<decltype(begin(std::declval<Collection>()))>::value_type;
 }
 
 
+/**
+ * @brief Lightweight view of a sub range of a zip_collection
+ * 
+ * Only holds a pair of zip_iterators, so it refers to the same collections without re-zipping them. Creating a
+ * sub range is O(1) when the iterators are random access, and linear otherwise. All positions passed to slice(),
+ * take(), and drop() must be within the range. This is not checked.
+ */
+template<typename Iter>
+class zip_range
+{
+public:
+    using iterator = Iter;
+    using const_iterator = Iter;
+    using difference_type = typename Iter::difference_type;
+
+    zip_range(Iter first_, Iter last_) : first(std::move(first_)), last(std::move(last_)) {}
+
+    Iter begin() const
+    {
+        return first;
+    }
+
+    Iter end() const
+    {
+        return last;
+    }
+
+    decltype(auto) rbegin() const
+    {
+        return last.reversed();
+    }
+
+    decltype(auto) rend() const
+    {
+        return first.reversed();
+    }
+
+    bool empty() const
+    {
+        return first == last;
+    }
+
+    /// Number of rows in the range. Only available for random access iterators
+    template<typename T = Iter>
+    auto size() const -> decltype(std::declval<const T&>() - std::declval<const T&>())
+    {
+        return last - first;
+    }
+
+    /// Rows [from, to) of this range
+    zip_range slice(difference_type from, difference_type to) const
+    {
+        auto new_first = std::next(first, from);
+        auto new_last = std::next(new_first, to - from);
+        return zip_range(std::move(new_first), std::move(new_last));
+    }
+
+    /// The first n rows of this range
+    zip_range take(difference_type n) const
+    {
+        return zip_range(first, std::next(first, n));
+    }
+
+    /// All but the first n rows of this range
+    zip_range drop(difference_type n) const
+    {
+        return zip_range(std::next(first, n), last);
+    }
+
+private:
+    Iter first;
+    Iter last;
+};
+
 template<typename ... Collections>
 class zip_collection
 {
@@ -211,13 +576,15 @@ public:
     decltype(auto) begin()
     {
         using std::begin;
-        return std::apply([](auto&&... cols){return iterator(begin(std::forward<Collections>(cols))...);}, col_tup);
+        return with_checks(
+            std::apply([](auto&&... cols){return iterator(begin(std::forward<Collections>(cols))...);}, col_tup));
     }
 
     decltype(auto) end()
     {
         using std::end;
-        return std::apply([](auto&&... cols){return iterator(end(std::forward<Collections>(cols))...);}, col_tup);
+        return with_checks(
+            std::apply([](auto&&... cols){return iterator(end(std::forward<Collections>(cols))...);}, col_tup));
     }
 
     decltype(auto) begin() const
@@ -233,18 +600,413 @@ public:
     decltype(auto) cbegin() const
     {
         using std::cbegin;
-        return std::apply([](auto&&... cols){return const_iterator(cbegin(std::forward<Collections>(cols))...);}, col_tup);
+        return with_checks(
+            std::apply([](auto&&... cols){return const_iterator(cbegin(std::forward<Collections>(cols))...);}, col_tup));
     }
 
     decltype(auto) cend() const
     {
         using std::cend;
-        return std::apply([](auto&&... cols){return const_iterator(cend(std::forward<Collections>(cols))...);}, col_tup);
+        return with_checks(
+            std::apply([](auto&&... cols){return const_iterator(cend(std::forward<Collections>(cols))...);}, col_tup));
+    }
+
+    /// The zipped collections, as references or (for zipped rvalues) the owned collections
+    tuple_type& columns()
+    {
+        return col_tup;
+    }
+
+    const tuple_type& columns() const
+    {
+        return col_tup;
+    }
+
+    // Reverse iteration is only available if all the collections are bidirectional
+    decltype(auto) rbegin()
+    {
+        return this->end().reversed();
+    }
+
+    decltype(auto) rend()
+    {
+        return this->begin().reversed();
+    }
+
+    decltype(auto) rbegin() const
+    {
+        return this->crbegin();
+    }
+
+    decltype(auto) rend() const
+    {
+        return this->crend();
+    }
+
+    decltype(auto) crbegin() const
+    {
+        return this->cend().reversed();
+    }
+
+    decltype(auto) crend() const
+    {
+        return this->cbegin().reversed();
+    }
+
+    /// View of rows [first, last). O(1) if all collections are random access
+    auto slice(std::ptrdiff_t first, std::ptrdiff_t last)
+    {
+        return zip_range<iterator>(this->begin(), this->end()).slice(first, last);
+    }
+
+    auto slice(std::ptrdiff_t first, std::ptrdiff_t last) const
+    {
+        return zip_range<const_iterator>(this->cbegin(), this->cend()).slice(first, last);
+    }
+
+    /// View of the first n rows. O(1) if all collections are random access
+    auto take(std::ptrdiff_t n)
+    {
+        return zip_range<iterator>(this->begin(), this->end()).take(n);
+    }
+
+    auto take(std::ptrdiff_t n) const
+    {
+        return zip_range<const_iterator>(this->cbegin(), this->cend()).take(n);
+    }
+
+    /// View of all but the first n rows. O(1) if all collections are random access
+    auto drop(std::ptrdiff_t n)
+    {
+        return zip_range<iterator>(this->begin(), this->end()).drop(n);
+    }
+
+    auto drop(std::ptrdiff_t n) const
+    {
+        return zip_range<const_iterator>(this->cbegin(), this->cend()).drop(n);
     }
 
 private:
+    /// Attach a record of the collections to it when ZIPPP_ENABLE_CHECKS is defined, otherwise return it unchanged
+    template<typename Iter>
+    Iter with_checks(Iter it) const
+    {
+#ifdef ZIPPP_ENABLE_CHECKS
+        using checks_type = zip_checks_for<std::remove_cv_t<std::remove_reference_t<Collections>>...>;
+        it.attach_checks(std::apply([](const auto& ... cols) {
+            return std::make_shared<const checks_type>(writable_columns<Iter>::value, cols...);
+        }, col_tup));
+#endif
+        return it;
+    }
+
     tuple_type col_tup;
 };
+#ifdef ZIPPP_ENABLE_INSTRUMENTATION
+inline std::uint64_t read_cycle_counter()
+{
+#ifdef ZIPPP_HAS_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Tracks a single pass over an instrumented zip and reports it to Sink when finished
+ *
+ * Copies start out idle so that copying a collection never reports the same pass twice. The iterators of one pass may
+ * be moved on several threads, but passes must start and end on one thread at a time: a single instrumented zip cannot
+ * be iterated by independent loops on several threads at once, even if it is const.
+ */
+template<typename Sink, std::size_t ... ElemSizes>
+class loop_probe
+{
+public:
+    loop_probe() = default;
+    loop_probe(const loop_probe&) {}
+    loop_probe& operator=(const loop_probe&) { return *this; }
+    ~loop_probe() { finish(); }
+
+    void start()
+    {
+        finish();
+        elements = 0;
+        active = true;
+        start_cycles = read_cycle_counter();
+        start_time = std::chrono::steady_clock::now();
+    }
+
+    /// Rows may be counted from several threads, e.g. the chunks of parallel_transform_into
+    void step(std::size_t rows) { elements.fetch_add(rows, std::memory_order_relaxed); }
+
+    void finish()
+    {
+        if(!active)
+        {
+            return;
+        }
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto end_cycles = read_cycle_counter();
+        active = false;
+
+        const std::size_t rows = elements.load(std::memory_order_relaxed);
+        std::array<std::size_t, sizeof...(ElemSizes)> column_bytes{(ElemSizes * rows)...};
+        zip_loop_stats stats;
+        stats.elements = rows;
+        stats.columns = sizeof...(ElemSizes);
+        stats.row_bytes = (std::size_t{0} + ... + ElemSizes);
+        stats.column_bytes = column_bytes.data();
+        stats.wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+        stats.cycles = end_cycles - start_cycles;
+        Sink::report(stats);
+    }
+
+private:
+    std::atomic<std::size_t> elements{0};
+    bool active = false;
+    std::uint64_t start_cycles = 0;
+    std::chrono::steady_clock::time_point start_time;
+};
+
+/**
+ * @brief zip_iterator that counts the rows it moves and ends the pass when it reaches the end
+ *
+ * ++, --, += and -= count the rows moved. + and - return new iterators without counting. Only iterators created by
+ * end() (of the collection or of one of its slices) end the pass when compared equal, so comparing against the end of
+ * a block part way through does not report an incomplete pass.
+ */
+template<typename Iter, typename Probe>
+class instrumented_iterator : public Iter
+{
+public:
+    instrumented_iterator(Iter it, Probe* probe_, bool is_end_ = false)
+        : Iter(std::move(it)), probe(probe_), is_end(is_end_) {}
+
+    instrumented_iterator& operator++()
+    {
+        moved(1);
+        Iter::operator++();
+        return *this;
+    }
+    instrumented_iterator operator++(int)
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    template<typename T = Iter, typename = decltype(--std::declval<T&>())>
+    instrumented_iterator& operator--()
+    {
+        moved(1);
+        Iter::operator--();
+        return *this;
+    }
+    template<typename T = Iter, typename = decltype(--std::declval<T&>())>
+    instrumented_iterator operator--(int)
+    {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+    template<typename T = Iter, typename = decltype(std::declval<T&>() += 1)>
+    instrumented_iterator& operator+=(std::ptrdiff_t i)
+    {
+        moved(i);
+        Iter::operator+=(i);
+        return *this;
+    }
+    template<typename T = Iter, typename = decltype(std::declval<T&>() += 1)>
+    instrumented_iterator operator+(std::ptrdiff_t i) const
+    {
+        return instrumented_iterator(static_cast<const Iter&>(*this) + i, probe);
+    }
+    template<typename T = Iter, typename = decltype(std::declval<T&>() -= 1)>
+    instrumented_iterator& operator-=(std::ptrdiff_t i)
+    {
+        moved(i);
+        Iter::operator-=(i);
+        return *this;
+    }
+    template<typename T = Iter, typename = decltype(std::declval<T&>() -= 1)>
+    instrumented_iterator operator-(std::ptrdiff_t i) const
+    {
+        return instrumented_iterator(static_cast<const Iter&>(*this) - i, probe);
+    }
+    template<typename T = Iter, typename = decltype(std::declval<const T&>() - std::declval<const T&>())>
+    typename Iter::difference_type operator-(const instrumented_iterator& in) const
+    {
+        return static_cast<const Iter&>(*this) - static_cast<const Iter&>(in);
+    }
+
+    bool operator==(const instrumented_iterator& in) const
+    {
+        const bool equal = static_cast<const Iter&>(*this) == static_cast<const Iter&>(in);
+        if(equal && (is_end || in.is_end))
+        {
+            probe->finish();
+        }
+        return equal;
+    }
+    bool operator!=(const instrumented_iterator& in) const
+    {
+        return !(*this == in);
+    }
+
+private:
+    void moved(std::ptrdiff_t rows)
+    {
+        probe->step(static_cast<std::size_t>(rows < 0 ? -rows : rows));
+        is_end = false;
+    }
+
+    Probe* probe;
+    bool is_end;
+};
+
+/**
+ * @brief zip_collection whose iterators report each pass to Sink
+ */
+template<typename Sink, typename ... Collections>
+class instrumented_zip_collection : public zip_collection<Collections...>
+{
+    using base = zip_collection<Collections...>;
+    using probe_type = loop_probe<Sink, sizeof(zip_iter_types::value_type<Collections>)...>;
+
+public:
+    using iterator = instrumented_iterator<typename base::iterator, probe_type>;
+    using const_iterator = instrumented_iterator<typename base::const_iterator, probe_type>;
+
+    using base::base;
+
+    iterator begin()
+    {
+        probe.start();
+        return iterator(base::begin(), &probe);
+    }
+
+    iterator end()
+    {
+        return iterator(base::end(), &probe, true);
+    }
+
+    const_iterator begin() const
+    {
+        return this->cbegin();
+    }
+
+    const_iterator end() const
+    {
+        return this->cend();
+    }
+
+    const_iterator cbegin() const
+    {
+        probe.start();
+        return const_iterator(base::cbegin(), &probe);
+    }
+
+    const_iterator cend() const
+    {
+        return const_iterator(base::cend(), &probe, true);
+    }
+
+    // Reverse iteration is only available if all the collections are bidirectional
+    auto rbegin()
+    {
+        probe.start();
+        return reversed(base::end(), false);
+    }
+
+    auto rend()
+    {
+        return reversed(base::begin(), true);
+    }
+
+    auto rbegin() const
+    {
+        return this->crbegin();
+    }
+
+    auto rend() const
+    {
+        return this->crend();
+    }
+
+    auto crbegin() const
+    {
+        probe.start();
+        return reversed(base::cend(), false);
+    }
+
+    auto crend() const
+    {
+        return reversed(base::cbegin(), true);
+    }
+
+    /// Views over part of the collection. Iterating one to its end reports it as a pass
+    auto slice(std::ptrdiff_t first, std::ptrdiff_t last)
+    {
+        return instrument(base::slice(first, last));
+    }
+
+    auto slice(std::ptrdiff_t first, std::ptrdiff_t last) const
+    {
+        return instrument(base::slice(first, last));
+    }
+
+    auto take(std::ptrdiff_t n)
+    {
+        return instrument(base::take(n));
+    }
+
+    auto take(std::ptrdiff_t n) const
+    {
+        return instrument(base::take(n));
+    }
+
+    auto drop(std::ptrdiff_t n)
+    {
+        return instrument(base::drop(n));
+    }
+
+    auto drop(std::ptrdiff_t n) const
+    {
+        return instrument(base::drop(n));
+    }
+
+private:
+    template<typename Iter>
+    auto reversed(const Iter& it, bool is_end) const
+    {
+        using reverse_iterator = instrumented_iterator<decltype(it.reversed()), probe_type>;
+        return reverse_iterator(it.reversed(), &probe, is_end);
+    }
+
+    /// Wrap a range of the base collection, positioning it without counting any rows
+    template<typename Range>
+    auto instrument(const Range& range) const
+    {
+        using range_iterator = instrumented_iterator<typename Range::iterator, probe_type>;
+        probe.start();
+        return zip_range<range_iterator>(range_iterator(range.begin(), &probe),
+                                         range_iterator(range.end(), &probe, true));
+    }
+
+    mutable probe_type probe;
+};
+
+template<typename Policy, typename ... Collections>
+struct policy_collection;
+
+template<typename Sink, typename ... Collections>
+struct policy_collection<basic_instrumented<Sink>, Collections...>
+{
+    using type = instrumented_zip_collection<Sink, Collections...>;
+};
+#endif
 } // namespace detail
 
 /**
@@ -261,6 +1023,24 @@ auto zip(Collections&& ... collections)
 {
     return detail::zip_collection<decltype((std::forward<Collections>(collections)))...>(std::forward<Collections>(collections)...);
 }
+
+/**
+ * @brief Creates a zip of the provided collections that uses the provided policy
+ * 
+ * The only policy is zippp::instrumented (or basic_instrumented<Sink>), which reports the number of rows, bytes and time
+ * of each pass over the collection. Unless ZIPPP_ENABLE_INSTRUMENTATION is defined this is exactly the same as zip().
+ */
+template<typename Policy, typename ... Collections, typename = std::enable_if_t<detail::is_zip_policy<Policy>::value>>
+auto zip(Collections&& ... collections)
+{
+#ifdef ZIPPP_ENABLE_INSTRUMENTATION
+    using collection_type = typename detail::policy_collection<Policy, 
+        decltype((std::forward<Collections>(collections)))...>::type;
+    return collection_type(std::forward<Collections>(collections)...);
+#else
+    return zip(std::forward<Collections>(collections)...);
+#endif
+}
 } // namespace zippp
 
 // Template specializations for zip_iter_value to let it be bound by structured bindings
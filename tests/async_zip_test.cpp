@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include "zippp/async_zip.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+zippp::async_generator<int> count_to(int n)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        co_yield i;
+    }
+}
+
+zippp::async_generator<int> throw_after(int n)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        co_yield i;
+    }
+    throw std::runtime_error("source failed");
+}
+
+template<typename T, typename F>
+std::thread produce(zippp::async_channel<T>& channel, int n, F make, std::chrono::microseconds delay)
+{
+    return std::thread([&channel, n, make, delay] {
+        for(int i = 0; i < n; ++i)
+        {
+            std::this_thread::sleep_for(delay);
+            channel.push(make(i));
+        }
+        channel.close();
+    });
+}
+}
+
+TEST(ZipppAsyncTests, generatorTest)
+{
+    auto gen = count_to(3);
+    std::vector<int> values;
+    while(auto value = zippp::sync_wait(gen.next()))
+    {
+        values.push_back(*value);
+    }
+    EXPECT_EQ((std::vector<int>{0, 1, 2}), values);
+    EXPECT_FALSE(zippp::sync_wait(gen.next()));
+}
+
+TEST(ZipppAsyncTests, zipGeneratorsTest)
+{
+    auto gen = zippp::async_zip(count_to(5), count_to(3));
+    int count = 0;
+    while(auto row = zippp::sync_wait(gen.next()))
+    {
+        auto [a, b] = *row;
+        EXPECT_EQ(count, a);
+        EXPECT_EQ(count, b);
+        ++count;
+    }
+    EXPECT_EQ(3, count);
+}
+
+TEST(ZipppAsyncTests, zipChannelsTest)
+{
+    constexpr int rows = 200;
+    zippp::async_channel<int> ints;
+    zippp::async_channel<std::string> strings;
+    auto t1 = produce(ints, rows, [](int i) { return i; }, std::chrono::microseconds(5));
+    auto t2 = produce(strings, rows, [](int i) { return std::to_string(i); }, std::chrono::microseconds(1));
+
+    auto gen = zippp::async_zip(ints, strings, count_to(rows + 10));
+    int count = 0;
+    while(auto row = zippp::sync_wait(gen.next()))
+    {
+        auto& [i, s, c] = *row;
+        EXPECT_EQ(count, i);
+        EXPECT_EQ(std::to_string(count), s);
+        ASSERT_EQ(count, c);
+        ++count;
+    }
+    t1.join();
+    t2.join();
+    EXPECT_EQ(rows, count);
+}
+
+TEST(ZipppAsyncTests, zipBatchedTest)
+{
+    constexpr int rows = 1000;
+    zippp::async_channel<int> ints;
+    zippp::async_channel<double> doubles;
+    auto t1 = produce(ints, rows, [](int i) { return i; }, std::chrono::microseconds(0));
+    auto t2 = produce(doubles, rows - 1, [](int i) { return i * 0.5; }, std::chrono::microseconds(0));
+
+    auto gen = zippp::async_zip_batched(64, ints, doubles, count_to(rows));
+    int count = 0;
+    while(auto row = zippp::sync_wait(gen.next()))
+    {
+        auto [i, d, c] = *row;
+        EXPECT_EQ(count, i);
+        EXPECT_EQ(count * 0.5, d);
+        ASSERT_EQ(count, c);
+        ++count;
+    }
+    t1.join();
+    t2.join();
+    EXPECT_EQ(rows - 1, count);
+}
+
+TEST(ZipppAsyncTests, exceptionTest)
+{
+    auto gen = zippp::async_zip(count_to(10), throw_after(2));
+    EXPECT_TRUE(zippp::sync_wait(gen.next()));
+    EXPECT_TRUE(zippp::sync_wait(gen.next()));
+    EXPECT_THROW(zippp::sync_wait(gen.next()), std::runtime_error);
+    EXPECT_FALSE(zippp::sync_wait(gen.next()));
+}
+#endif
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "zippp/zip.h"
+#include "zippp/bits.h"
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+std::vector<bool> pattern(std::size_t size, std::size_t seed)
+{
+    std::vector<bool> bits(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        bits[i] = (i * 7 + seed) % 3 == 0 || (i ^ seed) % 5 == 1;
+    }
+    return bits;
+}
+}
+
+TEST(ZipppBitsTests, andNotTest)
+{
+    for(std::size_t size : {0, 1, 63, 64, 65, 1000})
+    {
+        const auto a = pattern(size, 1);
+        const auto b = pattern(size, 2);
+        std::vector<bool> out(size + 10, true);
+        std::size_t words = 0;
+        for(auto&& [wa, wb, wo] : zippp::zip_words(a, b, out))
+        {
+            wo = wa & ~wb;
+            ++words;
+        }
+        EXPECT_EQ((size + 63) / 64, words);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            ASSERT_EQ(a[i] && !b[i], out[i]) << "size " << size << " row " << i;
+        }
+        // Rows past the end of the shortest column are untouched
+        for(std::size_t i = size; i < out.size(); ++i)
+        {
+            ASSERT_TRUE(out[i]);
+        }
+    }
+}
+
+TEST(ZipppBitsTests, bitsetTest)
+{
+    std::bitset<130> flags;
+    flags.set(0).set(64).set(129);
+    auto other = pattern(130, 3);
+    for(auto&& [f, o] : zippp::zip_words(flags, other))
+    {
+        f |= o;
+        o = f;
+    }
+    for(std::size_t i = 0; i < flags.size(); ++i)
+    {
+        const bool expected = i == 0 || i == 64 || i == 129 || pattern(130, 3)[i];
+        ASSERT_EQ(expected, flags[i]) << "row " << i;
+        ASSERT_EQ(expected, other[i]) << "row " << i;
+    }
+}
+
+TEST(ZipppBitsTests, wordAccessTest)
+{
+    std::vector<bool> a(100);
+    a[3] = true;
+    a[70] = true;
+    a[99] = true;
+    const std::bitset<128> b;
+    std::vector<std::size_t> rows;
+    for(const auto& [wa, wb] : zippp::zip_words(a, b))
+    {
+        EXPECT_EQ(0u, wb.value());
+        for(std::size_t bit = 0; bit < 64; ++bit)
+        {
+            if(wa[bit])
+            {
+                rows.push_back(wa.first_row() + bit);
+            }
+        }
+    }
+    EXPECT_EQ((std::vector<std::size_t>{3, 70, 99}), rows);
+
+    auto words = zippp::zip_words(a, b);
+    EXPECT_EQ(100u, words.rows());
+    EXPECT_EQ(2u, words.size());
+    auto it = words.begin();
+    ++it;
+    auto [last, unused] = *it;
+    EXPECT_EQ((std::uint64_t(1) << 36) - 1, last.mask());
+}
+
+TEST(ZipppBitsTests, bitLevelTest)
+{
+    std::vector<bool> a = pattern(200, 4);
+    std::vector<bool> b = pattern(200, 5);
+    std::size_t words_count = 0;
+    for(auto&& [wa, wb] : zippp::zip_words(a, b))
+    {
+        words_count += std::bitset<64>(wa & wb).count();
+    }
+    std::size_t rows_count = 0;
+    for(auto&& [x, y] : zippp::zip(a, b))
+    {
+        rows_count += x && y;
+    }
+    EXPECT_EQ(rows_count, words_count);
+}
+
+TEST(ZipppBitsTests, libraryWordsTest)
+{
+    std::vector<bool> v(100);
+    const std::bitset<128> b;
+    auto v_words = zippp::detail::library_words(v);
+    auto b_words = zippp::detail::library_words(b);
+    (void)v_words;
+    (void)b_words;
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)
+    // Guards against libstdc++ changing the internals the word level fast path relies on
+    if constexpr (std::is_same_v<unsigned long, std::uint64_t>)
+    {
+        static_assert(std::is_same_v<std::uint64_t*, decltype(v_words)>, "vector<bool> words are not reachable");
+        static_assert(std::is_same_v<const std::uint64_t*, decltype(b_words)>, "bitset words are not reachable");
+        v[70] = true;
+        EXPECT_EQ(std::uint64_t(1) << 6, v_words[1]);
+    }
+#else
+    static_assert(std::is_same_v<std::nullptr_t, decltype(v_words)>, "Unexpected word access to vector<bool>");
+    static_assert(std::is_same_v<std::nullptr_t, decltype(b_words)>, "Unexpected word access to bitset");
+#endif
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include "zippp/zip.h"
+
+#include <list>
+#include <utility>
+#include <vector>
+
+#ifndef ZIPPP_ENABLE_CHECKS
+#error "checks_test.cpp must be built with ZIPPP_ENABLE_CHECKS"
+#endif
+
+namespace
+{
+/// Minimal non owning view with data() and size(), like a C++20 std::span
+struct int_span
+{
+    int* ptr;
+    std::size_t count;
+
+    int* data() const
+    {
+        return ptr;
+    }
+    std::size_t size() const
+    {
+        return count;
+    }
+    int* begin() const
+    {
+        return ptr;
+    }
+    int* end() const
+    {
+        return ptr + count;
+    }
+};
+}
+
+TEST(ZipppChecksDeathTest, reallocationTest)
+{
+    std::vector<int> a{1, 2, 3};
+    std::vector<int> b{4, 5, 6};
+    a.shrink_to_fit();
+    EXPECT_DEATH(
+        {
+            for(auto&& [x, y] : zippp::zip(a, b))
+            {
+                a.push_back(x + y);
+            }
+        },
+        "was reallocated during iteration");
+}
+
+TEST(ZipppChecksDeathTest, unevenGrowthTest)
+{
+    std::vector<int> a{1, 2, 3};
+    std::vector<int> b{4, 5, 6};
+    b.reserve(100);
+    EXPECT_DEATH(
+        {
+            for(auto&& [x, y] : zippp::zip(a, b))
+            {
+                b.push_back(x + y);
+            }
+        },
+        "different lengths");
+}
+
+TEST(ZipppChecksDeathTest, lengthMismatchTest)
+{
+    std::vector<int> a{1, 2, 3};
+    std::list<int> b{4, 5};
+    EXPECT_DEATH(
+        {
+            for(auto&& [x, y] : zippp::zip(a, b))
+            {
+                x = y;
+            }
+        },
+        "different lengths");
+}
+
+TEST(ZipppChecksDeathTest, overlapTest)
+{
+    std::vector<int> a{1, 2, 3};
+    EXPECT_DEATH(
+        {
+            for(auto&& [x, y] : zippp::zip(a, a))
+            {
+                x = y * 2;
+            }
+        },
+        "overlap");
+
+    // Views into the same buffer only overlap if their ranges do
+    int data[10] = {};
+    EXPECT_DEATH(
+        {
+            for(auto&& [x, y] : zippp::zip(int_span{data, 5}, int_span{data + 4, 5}))
+            {
+                x = y;
+            }
+        },
+        "overlap");
+    for(auto&& [x, y] : zippp::zip(int_span{data, 5}, int_span{data + 5, 5}))
+    {
+        y = x + 1;
+    }
+    EXPECT_EQ(1, data[9]);
+}
+
+TEST(ZipppChecksTests, validLoopsTest)
+{
+    std::vector<int> a{1, 2, 3, 4};
+    std::list<int> b{5, 6, 7, 8};
+    int c[] = {0, 0, 0, 0};
+    for(auto&& [x, y, z] : zippp::zip(a, b, c))
+    {
+        z = x + y;
+    }
+    EXPECT_EQ(6, c[0]);
+    EXPECT_EQ(12, c[3]);
+
+    // Writing elements is fine, only resizing is not
+    std::vector<int> d(4);
+    auto zipped = zippp::zip(a, d);
+    for(auto it = zipped.rbegin(); it != zipped.rend(); ++it)
+    {
+        auto&& [x, y] = *it;
+        y = x * 2;
+    }
+    EXPECT_EQ((std::vector<int>{2, 4, 6, 8}), d);
+
+    // Growing all collections together without reallocating is fine
+    a.reserve(100);
+    d.reserve(100);
+    for(auto&& [x, y] : zippp::zip(a, d))
+    {
+        if(a.size() < 8)
+        {
+            a.push_back(x);
+            d.push_back(y);
+        }
+    }
+    EXPECT_EQ(8u, a.size());
+    a.resize(4);
+    d.resize(4);
+
+    // Resizing between passes is fine
+    a.push_back(5);
+    d.push_back(0);
+    int sum = 0;
+    for(const auto& [x, y] : zipped)
+    {
+        sum += x;
+    }
+    EXPECT_EQ(15, sum);
+}
+
+TEST(ZipppChecksTests, readOnlyOverlapTest)
+{
+    // Zipping a collection with itself is only a problem if it is written through
+    const std::vector<int> a{1, 2, 3};
+    int sum = 0;
+    for(const auto& [x, y] : zippp::zip(a, a))
+    {
+        sum += x * y;
+    }
+    EXPECT_EQ(14, sum);
+
+    // As is writing through only one of them
+    std::vector<int> b{1, 2, 3};
+    auto zipped = zippp::zip(std::as_const(b), b);
+    for(auto it = zipped.begin(); it != zipped.end(); ++it)
+    {
+        auto& row = *it;
+        row.get<1>() = row.get<0>() * 2;
+    }
+    EXPECT_EQ((std::vector<int>{2, 4, 6}), b);
+}
+
+TEST(ZipppChecksTests, ownedCollectionsTest)
+{
+    int sum = 0;
+    for(const auto& [x, y] : zippp::zip(std::vector<int>{1, 2}, std::vector<int>{3, 4}))
+    {
+        sum += x + y;
+    }
+    EXPECT_EQ(10, sum);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "zippp/zip.h"
+#include "zippp/columns.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(ZipppColumnsTests, bitpackedTest)
+{
+    std::vector<std::uint32_t> values;
+    for(std::uint32_t i = 0; i < 200; ++i)
+    {
+        values.push_back((i * 37) % 128);
+    }
+    zippp::bitpacked_column<7, std::uint32_t> col(values.begin(), values.end());
+    EXPECT_EQ(values.size(), col.size());
+    EXPECT_EQ(4 * 7 * sizeof(std::uint64_t), col.memory_bytes());
+    EXPECT_EQ(values, std::vector<std::uint32_t>(col.begin(), col.end()));
+}
+
+TEST(ZipppColumnsTests, bitpackedWidthsTest)
+{
+    zippp::bitpacked_column<1, std::uint8_t> bits{1, 0, 1, 1};
+    EXPECT_EQ((std::vector<std::uint8_t>{1, 0, 1, 1}), std::vector<std::uint8_t>(bits.begin(), bits.end()));
+
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    zippp::bitpacked_column<64> full{max, 0, max - 1};
+    EXPECT_EQ((std::vector<std::uint64_t>{max, 0, max - 1}), std::vector<std::uint64_t>(full.begin(), full.end()));
+
+    zippp::bitpacked_column<3, std::uint16_t> truncated{9};
+    EXPECT_EQ(1, *truncated.begin());
+
+    zippp::bitpacked_column<5> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(ZipppColumnsTests, deltaTest)
+{
+    std::vector<std::int64_t> values;
+    for(std::int64_t i = 0; i < 300; ++i)
+    {
+        values.push_back(1000000 + i * 3 - (i % 5) * 7);
+    }
+    values.push_back(std::numeric_limits<std::int64_t>::min());
+    values.push_back(std::numeric_limits<std::int64_t>::max());
+    values.push_back(-1);
+    zippp::delta_column<std::int64_t> col(values.begin(), values.end());
+    EXPECT_EQ(values.size(), col.size());
+    EXPECT_LT(col.memory_bytes(), values.size() * 2 + 32);
+    EXPECT_EQ(values, std::vector<std::int64_t>(col.begin(), col.end()));
+}
+
+TEST(ZipppColumnsTests, deltaUnsignedTest)
+{
+    zippp::delta_column<std::uint8_t> col{0, 255, 1, 128, 127};
+    EXPECT_EQ((std::vector<std::uint8_t>{0, 255, 1, 128, 127}), std::vector<std::uint8_t>(col.begin(), col.end()));
+}
+
+TEST(ZipppColumnsTests, dictTest)
+{
+    std::vector<std::string> values{"a", "bb", "a", "ccc", "bb", "a"};
+    zippp::dict_column<std::string, std::uint8_t> col(values.begin(), values.end());
+    EXPECT_EQ(3u, col.dictionary().size());
+    EXPECT_EQ(values.size(), col.memory_bytes());
+    EXPECT_EQ(values, std::vector<std::string>(col.begin(), col.end()));
+    EXPECT_EQ("ccc", col[3]);
+}
+
+TEST(ZipppColumnsTests, dictOverflowTest)
+{
+    std::vector<int> values(256);
+    for(int i = 0; i < 256; ++i)
+    {
+        values[i] = i * 3;
+    }
+    // Every code of std::uint8_t is usable
+    zippp::dict_column<int, std::uint8_t> full(values.begin(), values.end());
+    EXPECT_EQ(256u, full.dictionary().size());
+    EXPECT_EQ(values, std::vector<int>(full.begin(), full.end()));
+
+    values.push_back(-1);
+    EXPECT_THROW((zippp::dict_column<int, std::uint8_t>(values.begin(), values.end())), std::length_error);
+    // Repeating values already in the dictionary is fine
+    values.back() = 3;
+    EXPECT_NO_THROW((zippp::dict_column<int, std::uint8_t>(values.begin(), values.end())));
+}
+
+#ifndef NDEBUG
+TEST(ZipppColumnsDeathTest, dictInvalidCodeTest)
+{
+    EXPECT_DEATH((zippp::dict_column<int, std::uint8_t>({1, 2}, {0, 1, 2})), "out of range");
+}
+#endif
+
+TEST(ZipppColumnsTests, zipTest)
+{
+    std::vector<std::uint16_t> packed_values;
+    std::vector<int> deltas;
+    std::vector<std::string> names;
+    std::vector<double> plain;
+    for(int i = 0; i < 150; ++i)
+    {
+        packed_values.push_back(static_cast<std::uint16_t>(i % 1000));
+        deltas.push_back(i * 10);
+        names.push_back(i % 3 ? "odd" : "even");
+        plain.push_back(i * 0.5);
+    }
+    zippp::bitpacked_column<10, std::uint16_t> packed(packed_values.begin(), packed_values.end());
+    zippp::delta_column<int> delta(deltas.begin(), deltas.end());
+    zippp::dict_column<std::string> dict(names.begin(), names.end());
+
+    int i = 0;
+    for(const auto& [p, d, n, v] : zippp::zip(packed, delta, dict, plain))
+    {
+        static_assert(std::is_same_v<std::uint16_t, std::decay_t<decltype(p)>>, "Wrong type for bitpacked binding");
+        static_assert(std::is_same_v<int, std::decay_t<decltype(d)>>, "Wrong type for delta binding");
+        static_assert(std::is_same_v<std::string, std::decay_t<decltype(n)>>, "Wrong type for dict binding");
+        EXPECT_EQ(packed_values[i], p);
+        EXPECT_EQ(deltas[i], d);
+        EXPECT_EQ(names[i], n);
+        ASSERT_EQ(plain[i], v);
+        ++i;
+    }
+    EXPECT_EQ(150, i);
+
+    auto col = zippp::zip(dict, plain);
+    static_assert(std::is_same_v<std::random_access_iterator_tag, decltype(col)::iterator::iterator_category>,
+        "Zip of dict_column and vector is not random access");
+    auto [n, v] = *(col.begin() + 3);
+    EXPECT_EQ("even", n);
+    EXPECT_EQ(1.5, v);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "zippp/zip.h"
+#include "zippp/hash.h"
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST(ZipppHashTests, aggregateTest)
+{
+    std::vector<int> region;
+    std::vector<std::string> product;
+    std::vector<long long> sales;
+    std::vector<double> price;
+    std::map<std::tuple<int, std::string>, std::pair<long long, double>> expected;
+    for(int i = 0; i < 5000; ++i)
+    {
+        region.push_back(i % 7);
+        product.push_back("p" + std::to_string(i % 11));
+        sales.push_back(i);
+        price.push_back(i * 0.5);
+        auto& e = expected[{region.back(), product.back()}];
+        e.first += sales.back();
+        e.second = std::max(e.second, price.back());
+    }
+
+    struct acc_t
+    {
+        long long total;
+        double max_price;
+    };
+    auto result = zippp::hash_aggregate(zippp::zip(region, product), zippp::zip(sales, price),
+        [](acc_t& acc, long long s, double p) {
+            acc.total += s;
+            acc.max_price = std::max(acc.max_price, p);
+        }, acc_t{0, 0.0});
+
+    ASSERT_EQ(expected.size(), result.rows.size());
+    ASSERT_EQ(expected.size(), result.values.size());
+    for(std::size_t g = 0; g < result.rows.size(); ++g)
+    {
+        const std::size_t row = result.rows[g];
+        const auto& e = expected.at({region[row], product[row]});
+        EXPECT_EQ(e.first, result.values[g].total);
+        EXPECT_EQ(e.second, result.values[g].max_price);
+    }
+    // Groups are in order of their first row
+    for(std::size_t g = 0; g < result.rows.size(); ++g)
+    {
+        EXPECT_EQ(g, result.rows[g]);
+    }
+}
+
+TEST(ZipppHashTests, uniqueRowsTest)
+{
+    std::vector<int> a;
+    std::vector<char> b;
+    for(int i = 0; i < 20000; ++i)
+    {
+        a.push_back((i * 37) % 1000);
+        b.push_back(static_cast<char>('a' + i % 2));
+    }
+    const auto keys = zippp::zip(a, b);
+    auto rows = zippp::unique_rows(keys);
+    ASSERT_EQ(1000u, rows.size());
+    std::map<std::pair<int, char>, std::size_t> first;
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+        first.emplace(std::make_pair(a[i], b[i]), i);
+    }
+    ASSERT_EQ(first.size(), rows.size());
+    for(std::size_t i = 1; i < rows.size(); ++i)
+    {
+        EXPECT_LT(rows[i - 1], rows[i]);
+    }
+    for(auto row : rows)
+    {
+        EXPECT_EQ(row, first.at({a[row], b[row]}));
+    }
+}
+
+TEST(ZipppHashTests, floatKeysTest)
+{
+    std::vector<double> keys{0.0, -0.0, 1.5, 1.5, -1.5};
+    std::vector<int> ones(keys.size(), 1);
+    auto result = zippp::hash_aggregate(zippp::zip(keys), zippp::zip(ones), [](int& acc, int v) { acc += v; }, 0);
+    EXPECT_EQ((std::vector<std::size_t>{0, 2, 4}), result.rows);
+    EXPECT_EQ((std::vector<int>{2, 2, 1}), result.values);
+}
+
+TEST(ZipppHashTests, emptyTest)
+{
+    std::vector<int> keys;
+    std::vector<int> values;
+    auto result = zippp::hash_aggregate(zippp::zip(keys), zippp::zip(values), [](int& acc, int v) { acc += v; }, 0);
+    EXPECT_TRUE(result.rows.empty());
+    EXPECT_TRUE(result.values.empty());
+    EXPECT_TRUE(zippp::unique_rows(zippp::zip(keys)).empty());
+}
+
+TEST(ZipppHashTests, boolKeyTest)
+{
+    std::vector<int> ids{1, 2, 1, 2, 1, 3};
+    std::vector<bool> flags{true, false, false, false, true, true};
+    std::vector<int> ones(ids.size(), 1);
+    EXPECT_EQ((std::vector<std::size_t>{0, 1, 2, 5}), zippp::unique_rows(zippp::zip(ids, flags)));
+
+    auto result = zippp::hash_aggregate(zippp::zip(flags), zippp::zip(ones), [](int& acc, int v) { acc += v; }, 0);
+    EXPECT_EQ((std::vector<std::size_t>{0, 1}), result.rows);
+    EXPECT_EQ((std::vector<int>{3, 3}), result.values);
+}
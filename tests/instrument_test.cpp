@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include "zippp/zip.h"
+#include "zippp/pipeline.h"
+#include "zippp/transform.h"
+
+#include <vector>
+#include <list>
+#include <array>
+
+#ifndef ZIPPP_ENABLE_INSTRUMENTATION
+#error "instrument_test.cpp must be built with ZIPPP_ENABLE_INSTRUMENTATION"
+#endif
+
+namespace
+{
+std::vector<zippp::zip_loop_stats> reports;
+std::vector<std::vector<std::size_t>> report_bytes;
+
+struct recording_sink
+{
+    static void report(const zippp::zip_loop_stats& stats)
+    {
+        reports.push_back(stats);
+        report_bytes.emplace_back(stats.column_bytes, stats.column_bytes + stats.columns);
+    }
+};
+
+void clear_reports()
+{
+    reports.clear();
+    report_bytes.clear();
+}
+}
+
+TEST(ZipppInstrumentTests, typeTest)
+{
+    std::vector<int> v{1,2,3};
+    static_assert(!std::is_same_v<decltype(zippp::zip(v)), decltype(zippp::zip<zippp::instrumented>(v))>,
+        "Instrumented zip is the plain zip_collection");
+}
+
+TEST(ZipppInstrumentTests, loopTest)
+{
+    clear_reports();
+    std::vector<int> v{1,2,3};
+    std::list<double> l{2,4,6};
+    int count = 1;
+    for(auto&& [i, d] : zippp::zip<zippp::basic_instrumented<recording_sink>>(v, l))
+    {
+        EXPECT_EQ(count, i);
+        ASSERT_EQ(count * 2, d);
+        ++count;
+    }
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(3u, reports[0].elements);
+    EXPECT_EQ(2u, reports[0].columns);
+    EXPECT_EQ(sizeof(int) + sizeof(double), reports[0].row_bytes);
+    EXPECT_EQ((std::vector<std::size_t>{3 * sizeof(int), 3 * sizeof(double)}), report_bytes[0]);
+    EXPECT_GE(reports[0].wall_time.count(), 0);
+}
+
+TEST(ZipppInstrumentTests, multiPassTest)
+{
+    clear_reports();
+    std::array<char, 5> a{};
+    const auto col = zippp::zip<zippp::basic_instrumented<recording_sink>>(a);
+    for(const auto& [c] : col)
+    {
+        (void)c;
+    }
+    for(auto it = col.begin(); it != col.end(); it++) {}
+    ASSERT_EQ(2u, reports.size());
+    EXPECT_EQ(5u, reports[0].elements);
+    EXPECT_EQ(5u, reports[1].elements);
+}
+
+TEST(ZipppInstrumentTests, breakTest)
+{
+    clear_reports();
+    std::vector<int> v{1,2,3,4};
+    {
+        auto col = zippp::zip<zippp::basic_instrumented<recording_sink>>(v);
+        for(auto&& [i] : col)
+        {
+            if(i == 2)
+            {
+                break;
+            }
+        }
+        EXPECT_TRUE(reports.empty());
+    }
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(1u, reports[0].elements);
+}
+
+TEST(ZipppInstrumentTests, globalSinkTest)
+{
+    static std::size_t elements = 0;
+    zippp::set_instrumentation_sink([](const zippp::zip_loop_stats& stats){ elements += stats.elements; });
+    std::vector<bool> v{true, false};
+    for(auto&& [b] : zippp::zip<zippp::instrumented>(v))
+    {
+        (void)b;
+    }
+    zippp::set_instrumentation_sink(nullptr);
+    for(auto&& [b] : zippp::zip<zippp::instrumented>(v))
+    {
+        (void)b;
+    }
+    ASSERT_EQ(2u, elements);
+}
+
+TEST(ZipppInstrumentTests, randomAccessTest)
+{
+    clear_reports();
+    std::vector<int> v(10);
+    auto col = zippp::zip<zippp::basic_instrumented<recording_sink>>(v);
+    const auto e = col.end();
+    int visited = 0;
+    for(auto it = col.begin(); it != e; it += 2)
+    {
+        ++visited;
+    }
+    EXPECT_EQ(5, visited);
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(10u, reports[0].elements);
+
+    // Arithmetic keeps the instrumented type without moving any iterator
+    auto first = col.begin();
+    decltype(first) middle = first + 4;
+    EXPECT_EQ(4, middle - first);
+    EXPECT_EQ(first, middle - 4);
+    --middle;
+    EXPECT_EQ(3, middle - first);
+}
+
+TEST(ZipppInstrumentTests, sliceTest)
+{
+    clear_reports();
+    std::vector<int> v{1, 2, 3, 4, 5, 6, 7, 8};
+    auto col = zippp::zip<zippp::basic_instrumented<recording_sink>>(v);
+    int sum = 0;
+    for(auto&& [i] : col.slice(2, 6))
+    {
+        sum += i;
+    }
+    EXPECT_EQ(18, sum);
+    for(auto&& [i] : col.drop(5))
+    {
+        sum += i;
+    }
+    EXPECT_EQ(39, sum);
+    ASSERT_EQ(2u, reports.size());
+    EXPECT_EQ(4u, reports[0].elements);
+    EXPECT_EQ(3u, reports[1].elements);
+}
+
+TEST(ZipppInstrumentTests, pipelineTest)
+{
+    clear_reports();
+    std::vector<int> a(100, 1);
+    std::vector<int> b(100);
+    zippp::pipeline(zippp::zip<zippp::basic_instrumented<recording_sink>>(a, b))
+        .then([](int x, int& y) { y = x + 1; })
+        .then([](int, int& y) { y *= 2; })
+        .run(16 * 2 * sizeof(int));
+    EXPECT_EQ(std::vector<int>(100, 4), b);
+    // One pass, covering the rows of both stages
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(200u, reports[0].elements);
+}
+
+TEST(ZipppInstrumentTests, parallelTransformTest)
+{
+    clear_reports();
+    std::vector<long long> x(10000);
+    std::vector<long long> out(x.size());
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = static_cast<long long>(i);
+    }
+    // Every thread counts its rows into the same pass
+    zippp::parallel_transform_into(zippp::zip<zippp::basic_instrumented<recording_sink>>(x), zippp::zip(out),
+        [](long long a) { return a * 2; }, 4);
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        ASSERT_EQ(x[i] * 2, out[i]);
+    }
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(x.size(), reports[0].elements);
+}
+
+TEST(ZipppInstrumentTests, reverseTest)
+{
+    clear_reports();
+    std::vector<int> v{1, 2, 3, 4};
+    std::list<int> l{5, 6, 7, 8};
+    auto col = zippp::zip<zippp::basic_instrumented<recording_sink>>(v, l);
+    std::vector<int> seen;
+    for(auto it = col.rbegin(); it != col.rend(); ++it)
+    {
+        auto&& [i, j] = *it;
+        seen.push_back(i + j);
+    }
+    EXPECT_EQ((std::vector<int>{12, 10, 8, 6}), seen);
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(4u, reports[0].elements);
+
+    const auto& const_col = col;
+    int count = 0;
+    for(auto it = const_col.rbegin(); it != const_col.rend(); it++)
+    {
+        ++count;
+    }
+    EXPECT_EQ(4, count);
+    ASSERT_EQ(2u, reports.size());
+    EXPECT_EQ(4u, reports[1].elements);
+}
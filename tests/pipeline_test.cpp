@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "zippp/pipeline.h"
+
+#include <cmath>
+#include <list>
+#include <utility>
+#include <vector>
+
+TEST(ZipppPipelineTests, matchesSeparatePassesTest)
+{
+    const std::size_t rows = 10007;
+    std::vector<double> values(rows);
+    std::vector<double> weights(rows);
+    for(std::size_t i = 0; i < rows; ++i)
+    {
+        values[i] = std::sin(static_cast<double>(i)) * 100;
+        weights[i] = 1.0 + (i % 13);
+    }
+    std::vector<double> expected_values = values;
+    std::vector<double> expected_scores(rows);
+    std::vector<int> expected_flags(rows);
+    for(std::size_t i = 0; i < rows; ++i)
+    {
+        expected_values[i] = expected_values[i] / 100;
+    }
+    for(std::size_t i = 0; i < rows; ++i)
+    {
+        expected_scores[i] = expected_values[i] * weights[i];
+    }
+    for(std::size_t i = 0; i < rows; ++i)
+    {
+        expected_flags[i] = expected_scores[i] > 1.0;
+    }
+
+    std::vector<double> scores(rows);
+    std::vector<int> flags(rows);
+    zippp::pipeline(zippp::zip(values, weights, scores, flags))
+        .then([](double& v, double, double&, int&) { v = v / 100; })
+        .then([](double v, double w, double& s, int&) { s = v * w; })
+        .then([](double, double, double s, int& f) { f = s > 1.0; })
+        .run(4096);
+    EXPECT_EQ(expected_values, values);
+    EXPECT_EQ(expected_scores, scores);
+    EXPECT_EQ(expected_flags, flags);
+}
+
+TEST(ZipppPipelineTests, blockOrderTest)
+{
+    std::vector<int> a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<std::pair<int, int>> log;
+    auto zipped = zippp::zip(a);
+    auto pipe = zippp::pipeline(zipped)
+        .then([&](int i) { log.emplace_back(1, i); })
+        .then([&](int i) { log.emplace_back(2, i); });
+    pipe.run(4 * sizeof(int));
+
+    const std::vector<std::pair<int, int>> expected{
+        {1, 0}, {1, 1}, {1, 2}, {1, 3}, {2, 0}, {2, 1}, {2, 2}, {2, 3},
+        {1, 4}, {1, 5}, {1, 6}, {1, 7}, {2, 4}, {2, 5}, {2, 6}, {2, 7},
+        {1, 8}, {1, 9}, {2, 8}, {2, 9}};
+    EXPECT_EQ(expected, log);
+
+    // Blocks smaller than a row still make progress
+    log.clear();
+    pipe.run(1);
+    ASSERT_EQ(20u, log.size());
+    EXPECT_EQ(std::make_pair(2, 0), log[1]);
+}
+
+TEST(ZipppPipelineTests, ownedZipTest)
+{
+    std::vector<int> sums;
+    long long total = 0;
+    zippp::pipeline(zippp::zip(std::vector<int>{1, 2, 3}, std::vector<int>{10, 20, 30}))
+        .then([&](int a, int b) { sums.push_back(a + b); })
+        .then([&](int a, int) { total += a; })
+        .run();
+    EXPECT_EQ((std::vector<int>{11, 22, 33}), sums);
+    EXPECT_EQ(6, total);
+}
+
+TEST(ZipppPipelineTests, forwardIteratorTest)
+{
+    std::list<int> a{1, 2, 3, 4, 5};
+    std::vector<int> b(5);
+    const auto zipped = zippp::zip(a, b);
+    int sum = 0;
+    zippp::pipeline(zipped)
+        .then([&](const int& x, const int&) { sum += x; })
+        .run(3 * sizeof(int));
+    EXPECT_EQ(15, sum);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "zippp/simd.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Contiguous view used to test columns that do not start on an aligned address
+template<typename T>
+struct span
+{
+    T* ptr;
+    std::size_t count;
+
+    T* data() const { return ptr; }
+    std::size_t size() const { return count; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + count; }
+};
+
+const zippp::simd_isa all_isas[] = {zippp::simd_isa::scalar, zippp::simd_isa::sse2,
+                                    zippp::simd_isa::avx2, zippp::simd_isa::avx512};
+}
+
+TEST(ZipppSimdTests, lanesTest)
+{
+    using pack = zippp::lanes<int, 4>;
+    int values[4] = {1, 2, 3, 4};
+    auto a = pack::load(values);
+    auto b = a * 2 + 1;
+    EXPECT_EQ(9, b[3]);
+    EXPECT_EQ(14, (b - a).sum());
+    EXPECT_EQ(-4, (-a).min());
+    EXPECT_EQ(9, b.max());
+    auto c = pack::load(values, 2);
+    EXPECT_EQ(0, c[2]);
+    EXPECT_EQ(1.5, (zippp::lanes_cast<double>(a) / 2.0)[2]);
+    EXPECT_EQ(7, zippp::masked(zippp::lane_mask<4>{1}, a, 7)[1]);
+}
+
+TEST(ZipppSimdTests, transformTest)
+{
+    for(auto isa : all_isas)
+    {
+        for(std::size_t size : {0, 1, 3, 17, 64, 1001})
+        {
+            std::vector<float> a(size);
+            std::vector<double> b(size);
+            std::vector<double> out(size, -1);
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                a[i] = static_cast<float>(i);
+                b[i] = i * 0.25;
+            }
+            zippp::simd_for_each(isa, zippp::zip(std::as_const(a), std::as_const(b), out),
+                [](const auto& x, const auto& y, auto& o) { o = zippp::lanes_cast<double>(x) * 2.0 + y; });
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(a[i] * 2.0 + b[i], out[i]) << "size " << size << " row " << i;
+            }
+        }
+    }
+}
+
+TEST(ZipppSimdTests, unalignedTest)
+{
+    for(auto isa : all_isas)
+    {
+        for(std::size_t offset = 0; offset < 8; ++offset)
+        {
+            std::array<std::int32_t, 100> storage{};
+            std::array<std::int32_t, 100> other{};
+            for(std::size_t i = 0; i < storage.size(); ++i)
+            {
+                storage[i] = static_cast<std::int32_t>(i);
+                other[i] = 1;
+            }
+            span<std::int32_t> col{storage.data() + offset, 90};
+            span<const std::int32_t> rhs{other.data(), 90};
+            std::size_t calls = 0;
+            zippp::simd_for_each(isa, zippp::zip(col, rhs), [&](auto& x, const auto& y) { x += y * 10; ++calls; });
+            for(std::size_t i = 0; i < storage.size(); ++i)
+            {
+                const bool in_col = i >= offset && i < offset + 90;
+                ASSERT_EQ(static_cast<std::int32_t>(i) + (in_col ? 10 : 0), storage[i]);
+            }
+            EXPECT_GE(calls, 1u);
+        }
+    }
+}
+
+TEST(ZipppSimdTests, reductionTest)
+{
+    std::vector<long long> a(999);
+    std::vector<int> b(999);
+    long long expected = 0;
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = static_cast<long long>(i);
+        b[i] = static_cast<int>(i % 7) + 1;
+        expected += a[i] * b[i];
+    }
+    for(auto isa : all_isas)
+    {
+        long long total = 0;
+        std::size_t rows = 0;
+        const auto col = zippp::zip(a, b);
+        zippp::simd_for_each(isa, col, [&](auto mask, const auto& x, const auto& y) {
+            total += (x * zippp::lanes_cast<long long>(y)).sum();
+            for(std::size_t i = 0; i < mask.width; ++i)
+            {
+                rows += mask[i];
+            }
+        });
+        EXPECT_EQ(expected, total);
+        EXPECT_EQ(a.size(), rows);
+    }
+}
+
+TEST(ZipppSimdTests, laneWidthTest)
+{
+    std::vector<double> a(64);
+    std::vector<char> b(64);
+    std::size_t width = 0;
+    zippp::simd_for_each(zippp::zip(a, b), [&](auto& x, auto&) { width = x.width; });
+    switch(zippp::detect_simd_isa())
+    {
+    case zippp::simd_isa::avx512: EXPECT_EQ(8u, width); break;
+    case zippp::simd_isa::avx2: EXPECT_EQ(4u, width); break;
+    case zippp::simd_isa::sse2: EXPECT_EQ(2u, width); break;
+    case zippp::simd_isa::scalar: EXPECT_EQ(1u, width); break;
+    }
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "zippp/transform.h"
+
+#include <vector>
+#include <list>
+#include <array>
+#include <string>
+#include <stdexcept>
+
+TEST(ZipppTransformTests, singleOutputTest)
+{
+    std::vector<int> x{1,2,3};
+    std::vector<double> y{0.5,1.5,2.5};
+    std::vector<double> out(3);
+    zippp::transform_into(zippp::zip(x, y), zippp::zip(out), [](int a, double b){ return a + b; });
+    EXPECT_EQ(out, (std::vector<double>{1.5, 3.5, 5.5}));
+}
+
+TEST(ZipppTransformTests, multiOutputTest)
+{
+    std::vector<int> x{1,2,3};
+    std::list<int> y{4,5,6};
+    std::vector<int> sum(3);
+    std::array<std::string, 3> str;
+    zippp::transform_into(zippp::zip(x, y), zippp::zip(sum, str),
+        [](int a, int b){ return std::make_tuple(a + b, std::to_string(a * b)); });
+    EXPECT_EQ(sum, (std::vector<int>{5, 7, 9}));
+    EXPECT_EQ(str, (std::array<std::string, 3>{"4", "10", "18"}));
+}
+
+TEST(ZipppTransformTests, pairOutputTest)
+{
+    std::vector<int> x{1,2};
+    std::vector<std::pair<int, int>> out(2);
+    zippp::transform_into(zippp::zip(x), zippp::zip(out), [](int a){ return std::make_pair(a, -a); });
+    EXPECT_EQ(out[1], std::make_pair(2, -2));
+}
+
+TEST(ZipppTransformTests, boolOutputTest)
+{
+    std::vector<int> x{1,2,3};
+    std::vector<bool> out(3);
+    zippp::transform_into<zippp::store_policy::streaming>(zippp::zip(x), zippp::zip(out),
+        [](int a){ return a % 2 == 0; });
+    EXPECT_EQ(out, (std::vector<bool>{false, true, false}));
+}
+
+TEST(ZipppTransformTests, streamingTest)
+{
+    std::vector<int> x(1000);
+    std::vector<float> y(1000);
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = static_cast<int>(i);
+        y[i] = static_cast<float>(i) / 2;
+    }
+    std::vector<int> o1(1000);
+    std::vector<double> o2(1000);
+    std::vector<short> o3(1000);
+    zippp::transform_into<zippp::store_policy::streaming>(zippp::zip(x, y), zippp::zip(o1, o2, o3),
+        [](int a, float b){ return std::make_tuple(a * 2, double(b) + a, short(a % 7)); });
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_EQ(o1[i], x[i] * 2);
+        EXPECT_EQ(o2[i], double(y[i]) + x[i]);
+        ASSERT_EQ(o3[i], x[i] % 7);
+    }
+}
+
+TEST(ZipppTransformTests, parallelTest)
+{
+    for(std::size_t size : {0, 1, 63, 64, 1000, 4097})
+    {
+        std::vector<long long> x(size);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            x[i] = static_cast<long long>(i);
+        }
+        std::vector<long long> out(size, -1);
+        std::vector<double> out_stream(size, -1);
+        zippp::parallel_transform_into(zippp::zip(x), zippp::zip(out), [](long long a){ return a * 3; }, 4);
+        zippp::parallel_transform_into<zippp::store_policy::streaming>(zippp::zip(x), zippp::zip(out_stream),
+            [](long long a){ return a * 0.5; }, 3);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            EXPECT_EQ(out[i], x[i] * 3);
+            ASSERT_EQ(out_stream[i], x[i] * 0.5);
+        }
+    }
+}
+
+TEST(ZipppTransformTests, parallelExceptionTest)
+{
+    std::vector<int> x(1000, 1);
+    x[900] = 0;
+    std::vector<int> out(1000);
+    EXPECT_THROW(zippp::parallel_transform_into(zippp::zip(x), zippp::zip(out),
+        [](int a){ if(a == 0) throw std::runtime_error("zero"); return a; }, 4), std::runtime_error);
+}
@@ -524,4 +524,129 @@ TEST(ZipppTests, constBeginRefTest)
     EXPECT_EQ(val, 1);
     v.front() = 5;
     EXPECT_EQ(val, 5);
-}
\ No newline at end of file
+}
+#ifndef ZIPPP_ENABLE_INSTRUMENTATION
+TEST(ZipppTests, instrumentedDisabledTest)
+{
+    std::vector<int> v{1,2,3};
+    std::list<double> l{1,2,3};
+    // With instrumentation disabled the policy is dropped entirely, so the generated code is the same as zip()
+    static_assert(std::is_same_v<decltype(zippp::zip(v, l)), decltype(zippp::zip<zippp::instrumented>(v, l))>,
+        "Instrumented zip is not the plain zip_collection");
+    static_assert(std::is_same_v<decltype(zippp::zip(std::vector<int>{})), 
+                                 decltype(zippp::zip<zippp::instrumented>(std::vector<int>{}))>,
+        "Instrumented zip is not the plain zip_collection");
+
+    static int reports = 0;
+    zippp::set_instrumentation_sink([](const zippp::zip_loop_stats&){ ++reports; });
+    int count = 1;
+    for(auto&& [i, d] : zippp::zip<zippp::instrumented>(v, l))
+    {
+        EXPECT_EQ(count, i);
+        ASSERT_EQ(count++, d);
+    }
+    zippp::set_instrumentation_sink(nullptr);
+    ASSERT_EQ(0, reports);
+}
+#endif
+
+TEST(ZipppTests, reverseTest)
+{
+    std::vector<int> v{1,2,3};
+    std::list<double> l{2,4,6};
+    auto col = zippp::zip(v, l);
+    int count = 3;
+    for(auto it = col.rbegin(); it != col.rend(); ++it)
+    {
+        auto& [i, d] = *it;
+        EXPECT_EQ(count, i);
+        ASSERT_EQ(count * 2, d);
+        i = -i;
+        --count;
+    }
+    EXPECT_EQ(0, count);
+    EXPECT_EQ((std::vector<int>{-1,-2,-3}), v);
+}
+
+TEST(ZipppTests, constReverseTest)
+{
+    int v[3] = {1,2,3};
+    const auto col = zippp::zip(v);
+    auto it = col.rbegin();
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(((*it).get<0>()))>>, "Binding is not const");
+    auto [val] = *it;
+    EXPECT_EQ(3, val);
+    auto [val2] = *(it + 2);
+    EXPECT_EQ(1, val2);
+    EXPECT_EQ(3, col.crend() - col.crbegin());
+}
+
+TEST(ZipppTests, sliceTest)
+{
+    std::vector<int> v{0,1,2,3,4,5};
+    std::array<int, 6> a{0,10,20,30,40,50};
+    auto col = zippp::zip(v, a);
+
+    auto window = col.slice(2, 5);
+    EXPECT_EQ(3, window.size());
+    int count = 2;
+    for(auto&& [i, j] : window)
+    {
+        EXPECT_EQ(count, i);
+        ASSERT_EQ(count * 10, j);
+        ++count;
+    }
+    EXPECT_EQ(5, count);
+
+    for(auto it = window.rbegin(); it != window.rend(); ++it)
+    {
+        auto [i, j] = *it;
+        ASSERT_EQ(--count, i);
+    }
+    EXPECT_EQ(2, count);
+
+    auto inner = window.drop(1).take(1);
+    EXPECT_EQ(1, inner.size());
+    auto it = inner.begin();
+    auto& [i, j] = *it;
+    i = 100;
+    EXPECT_EQ(100, v[3]);
+    EXPECT_EQ(30, j);
+}
+
+TEST(ZipppTests, takeDropTest)
+{
+    std::list<int> l{1,2,3,4};
+    const auto col = zippp::zip(l);
+    int sum = 0;
+    for(const auto& [i] : col.take(2))
+    {
+        sum += i;
+    }
+    EXPECT_EQ(3, sum);
+    for(const auto& [i] : col.drop(3))
+    {
+        sum += i;
+    }
+    EXPECT_EQ(7, sum);
+    EXPECT_TRUE(col.drop(4).empty());
+    EXPECT_TRUE(col.slice(1, 1).empty());
+}
+
+TEST(ZipppTests, slidingWindowTest)
+{
+    std::vector<int> v{1,2,3,4,5};
+    std::vector<int> w{5,4,3,2,1};
+    auto col = zippp::zip(v, w);
+    std::vector<int> sums;
+    for(std::ptrdiff_t start = 0; start + 3 <= 5; ++start)
+    {
+        int sum = 0;
+        for(const auto& [a, b] : col.slice(start, start + 3))
+        {
+            sum += a * b;
+        }
+        sums.push_back(sum);
+    }
+    EXPECT_EQ((std::vector<int>{22, 25, 22}), sums);
+}